@@ -0,0 +1,372 @@
+#include "authenticator.h"
+#include "authenticator_p.h"
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtNetwork/QNetworkAccessManager>
+#include <limits>
+using namespace QtRestClient;
+
+const QByteArray Authenticator::AuthorizationHeader("Authorization");
+
+Authenticator::Authenticator(RestClient *client) :
+	RequestInterceptor(client),
+	d(new AuthenticatorPrivate(this, client))
+{
+	connect(d->refreshTimer, &QTimer::timeout,
+			this, [this](){
+		//long lifetimes exceed the timer range, and are scheduled in steps
+		if(d->needsRefresh())
+			refresh();
+		else
+			d->scheduleRefresh();
+	});
+	if(client)
+		client->addInterceptor(this);
+}
+
+Authenticator::~Authenticator()
+{
+	//nobody is left to refresh the token, so the parked replies get their original 401
+	d->replayParked(false);
+}
+
+RestClient *Authenticator::client() const
+{
+	return d->client;
+}
+
+QString Authenticator::accessToken() const
+{
+	return d->accessToken;
+}
+
+QString Authenticator::tokenType() const
+{
+	return d->tokenType;
+}
+
+QDateTime Authenticator::expiresAt() const
+{
+	return d->expiresAt;
+}
+
+QUrl Authenticator::tokenUrl() const
+{
+	return d->tokenUrl;
+}
+
+QString Authenticator::refreshToken() const
+{
+	return d->refreshToken;
+}
+
+QString Authenticator::clientId() const
+{
+	return d->clientId;
+}
+
+QString Authenticator::clientSecret() const
+{
+	return d->clientSecret;
+}
+
+int Authenticator::refreshMargin() const
+{
+	return d->refreshMargin;
+}
+
+bool Authenticator::isRefreshing() const
+{
+	return d->refreshing;
+}
+
+QByteArray Authenticator::authorization() const
+{
+	if(d->accessToken.isEmpty())
+		return QByteArray();
+	return d->tokenType.toUtf8() + ' ' + d->accessToken.toUtf8();
+}
+
+QNetworkReply *Authenticator::interceptRequest(RequestBuilder &builder)
+{
+	//catches up with a missed timer, i.e. after the system was suspended
+	if(!d->refreshing && d->needsRefresh())
+		refresh();
+	if(!d->accessToken.isEmpty())
+		builder.addHeader(AuthorizationHeader, authorization());
+	return nullptr;
+}
+
+void Authenticator::interceptReply(QNetworkReply *reply, int &status, QByteArray &data)
+{
+	Q_UNUSED(data);
+	if(status != 401)
+		return;
+
+	//every reply is replayed only once, a second 401 is passed on
+	auto replyPrivate = RestReplyPrivate::of(reply);
+	if(!replyPrivate || replyPrivate->property(AuthenticatorPrivate::PropertyReplayed).toBool())
+		return;
+	replyPrivate->setProperty(AuthenticatorPrivate::PropertyReplayed, true);
+	replyPrivate->parked = true;
+	d->parkedReplies.append(replyPrivate);
+
+	if(d->refreshing)
+		return;
+	else if(d->isBackingOff()) {
+		//a refresh just failed, the 401 is passed on instead of asking again
+		QTimer::singleShot(0, this, [this](){
+			d->replayParked(false);
+		});
+	} else if(reply->request().rawHeader(AuthorizationHeader) != authorization()) {
+		//the token has been refreshed since the request was sent
+		QTimer::singleShot(0, this, [this](){
+			d->replayParked(true);
+		});
+	} else
+		refresh();
+}
+
+void Authenticator::setAccessToken(const QString &accessToken, int expiresIn)
+{
+	d->accessToken = accessToken;
+	d->failedRefreshes = 0;
+	d->retryAfter = QDateTime();
+	if(expiresIn >= 0)
+		d->expiresAt = QDateTime::currentDateTimeUtc().addSecs(expiresIn);
+	else
+		d->expiresAt = QDateTime();
+	d->updateClientHeader();
+	d->scheduleRefresh();
+	emit accessTokenChanged(d->accessToken, {});
+}
+
+void Authenticator::refresh()
+{
+	if(d->refreshing)
+		return;
+	d->refreshTimer->stop();
+	d->setRefreshing(true);
+	startRefresh();
+}
+
+void Authenticator::setTokenType(QString tokenType)
+{
+	if (d->tokenType == tokenType)
+		return;
+
+	d->tokenType = tokenType;
+	d->updateClientHeader();
+	emit tokenTypeChanged(tokenType, {});
+}
+
+void Authenticator::setTokenUrl(QUrl tokenUrl)
+{
+	if (d->tokenUrl == tokenUrl)
+		return;
+
+	d->tokenUrl = tokenUrl;
+	emit tokenUrlChanged(tokenUrl, {});
+}
+
+void Authenticator::setRefreshToken(QString refreshToken)
+{
+	if (d->refreshToken == refreshToken)
+		return;
+
+	d->refreshToken = refreshToken;
+	emit refreshTokenChanged(refreshToken, {});
+}
+
+void Authenticator::setClientId(QString clientId)
+{
+	if (d->clientId == clientId)
+		return;
+
+	d->clientId = clientId;
+	emit clientIdChanged(clientId, {});
+}
+
+void Authenticator::setClientSecret(QString clientSecret)
+{
+	if (d->clientSecret == clientSecret)
+		return;
+
+	d->clientSecret = clientSecret;
+	emit clientSecretChanged(clientSecret, {});
+}
+
+void Authenticator::setRefreshMargin(int refreshMargin)
+{
+	if (d->refreshMargin == refreshMargin)
+		return;
+
+	d->refreshMargin = refreshMargin;
+	d->scheduleRefresh();
+	emit refreshMarginChanged(refreshMargin, {});
+}
+
+void Authenticator::startRefresh()
+{
+	if(!d->client || !d->tokenUrl.isValid() || d->refreshToken.isEmpty()) {
+		failRefresh(tr("Unable to refresh the access token without a token URL and refresh token"));
+		return;
+	}
+
+	QList<QPair<QString, QString>> fields {
+		{QStringLiteral("grant_type"), QStringLiteral("refresh_token")},
+		{QStringLiteral("refresh_token"), d->refreshToken}
+	};
+	if(!d->clientId.isEmpty())
+		fields.append({QStringLiteral("client_id"), d->clientId});
+	if(!d->clientSecret.isEmpty())
+		fields.append({QStringLiteral("client_secret"), d->clientSecret});
+
+	//sent directly, as the interceptors must not see the refresh itself
+	QNetworkRequest request(d->tokenUrl);
+	request.setHeader(QNetworkRequest::ContentTypeHeader, QByteArrayLiteral("application/x-www-form-urlencoded"));
+	request.setRawHeader("Accept", "application/json");
+	request.setSslConfiguration(d->client->sslConfiguration());
+	auto reply = d->client->manager()->post(request, AuthenticatorPrivate::formEncode(fields));
+	connect(reply, &QNetworkReply::finished, this, [this, reply](){
+		reply->deleteLater();
+		auto json = QJsonDocument::fromJson(reply->readAll()).object();
+		auto accessToken = json[QStringLiteral("access_token")].toString();
+		if(accessToken.isEmpty()) {
+			auto errorString = json[QStringLiteral("error_description")].toString();
+			if(errorString.isEmpty())
+				errorString = json[QStringLiteral("error")].toString();
+			if(errorString.isEmpty())
+				errorString = reply->errorString();
+			failRefresh(errorString);
+		} else {
+			auto tokenType = json[QStringLiteral("token_type")].toString();
+			if(!tokenType.isEmpty())
+				setTokenType(tokenType);
+			completeRefresh(accessToken,
+							json[QStringLiteral("expires_in")].toInt(-1),
+							json[QStringLiteral("refresh_token")].toString());
+		}
+	});
+}
+
+void Authenticator::completeRefresh(const QString &accessToken, int expiresIn, const QString &refreshToken)
+{
+	if(!refreshToken.isEmpty())
+		setRefreshToken(refreshToken);
+	setAccessToken(accessToken, expiresIn);
+	d->setRefreshing(false);
+	//always asynchronous, as the refresh may complete while a reply is being parked
+	QTimer::singleShot(0, this, [this](){
+		d->replayParked(true);
+	});
+}
+
+void Authenticator::failRefresh(const QString &errorString)
+{
+	//back off exponentially, so the expired token does not trigger a refresh for every request
+	auto delay = AuthenticatorPrivate::MinRetryDelay << qMin(d->failedRefreshes, 16);
+	d->failedRefreshes++;
+	d->retryAfter = QDateTime::currentDateTimeUtc().addSecs(qMin(delay, AuthenticatorPrivate::MaxRetryDelay));
+	d->setRefreshing(false);
+	d->scheduleRefresh();
+	emit refreshFailed(errorString, {});
+	QTimer::singleShot(0, this, [this](){
+		d->replayParked(false);
+	});
+}
+
+// ------------- Private Implementation -------------
+
+const QByteArray AuthenticatorPrivate::PropertyReplayed("__QtRestClient_AuthenticatorPrivate_PropertyReplayed");
+const int AuthenticatorPrivate::MinRetryDelay = 5;
+const int AuthenticatorPrivate::MaxRetryDelay = 300;
+
+AuthenticatorPrivate::AuthenticatorPrivate(Authenticator *q_ptr, RestClient *client) :
+	client(client),
+	accessToken(),
+	tokenType(QStringLiteral("Bearer")),
+	expiresAt(),
+	tokenUrl(),
+	refreshToken(),
+	clientId(),
+	clientSecret(),
+	refreshMargin(60),
+	refreshing(false),
+	failedRefreshes(0),
+	retryAfter(),
+	refreshTimer(new QTimer(q_ptr)),
+	parkedReplies(),
+	q(q_ptr)
+{
+	refreshTimer->setSingleShot(true);
+	refreshTimer->setTimerType(Qt::VeryCoarseTimer);
+}
+
+bool AuthenticatorPrivate::needsRefresh() const
+{
+	return expiresAt.isValid() &&
+			!isBackingOff() &&
+			QDateTime::currentDateTimeUtc().secsTo(expiresAt) <= refreshMargin;
+}
+
+bool AuthenticatorPrivate::isBackingOff() const
+{
+	return retryAfter.isValid() && QDateTime::currentDateTimeUtc() < retryAfter;
+}
+
+void AuthenticatorPrivate::scheduleRefresh()
+{
+	refreshTimer->stop();
+	if(!expiresAt.isValid() || refreshing)
+		return;
+	auto now = QDateTime::currentDateTimeUtc();
+	auto msecs = now.msecsTo(expiresAt) - refreshMargin * Q_INT64_C(1000);
+	if(retryAfter.isValid())
+		msecs = qMax(msecs, now.msecsTo(retryAfter));
+	refreshTimer->start(static_cast<int>(qBound<qint64>(0, msecs, std::numeric_limits<int>::max())));
+}
+
+void AuthenticatorPrivate::updateClientHeader()
+{
+	if(!client)
+		return;
+	auto value = q->authorization();
+	if(value.isEmpty())
+		client->removeGlobalHeader(Authenticator::AuthorizationHeader);
+	else
+		client->addGlobalHeader(Authenticator::AuthorizationHeader, value);
+}
+
+void AuthenticatorPrivate::setRefreshing(bool refreshing)
+{
+	if(this->refreshing == refreshing)
+		return;
+	this->refreshing = refreshing;
+	emit q->refreshingChanged(refreshing, {});
+}
+
+void AuthenticatorPrivate::replayParked(bool resend)
+{
+	auto replies = parkedReplies;
+	parkedReplies.clear();
+	auto value = q->authorization();
+	for(auto reply : replies) {
+		if(!reply)
+			continue;
+		if(resend)
+			reply->retryHeaders.insert(Authenticator::AuthorizationHeader, value);
+		reply->resume(resend);
+	}
+}
+
+QByteArray AuthenticatorPrivate::formEncode(const QList<QPair<QString, QString>> &fields)
+{
+	//QUrlQuery does not encode '+', which is a space in form data
+	QByteArrayList pairs;
+	pairs.reserve(fields.size());
+	for(auto field : fields)
+		pairs.append(QUrl::toPercentEncoding(field.first) + '=' + QUrl::toPercentEncoding(field.second));
+	return pairs.join('&');
+}
@@ -0,0 +1,133 @@
+#ifndef QTRESTCLIENT_AUTHENTICATOR_H
+#define QTRESTCLIENT_AUTHENTICATOR_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/requestinterceptor.h"
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qurl.h>
+
+namespace QtRestClient {
+
+class RestClient;
+
+class AuthenticatorPrivate;
+//! An interceptor that authorizes all requests of a client with an OAuth2 bearer token and refreshes it
+class Q_RESTCLIENT_EXPORT Authenticator : public RequestInterceptor
+{
+	Q_OBJECT
+	friend class AuthenticatorPrivate;
+
+	//! The access token that is sent with every request
+	Q_PROPERTY(QString accessToken READ accessToken NOTIFY accessTokenChanged)
+	//! The type of the access token, used as scheme of the Authorization header
+	Q_PROPERTY(QString tokenType READ tokenType WRITE setTokenType NOTIFY tokenTypeChanged)
+	//! The time the access token expires at, or an invalid time if it does not expire
+	Q_PROPERTY(QDateTime expiresAt READ expiresAt NOTIFY accessTokenChanged)
+	//! The OAuth2 token endpoint to refresh the access token with
+	Q_PROPERTY(QUrl tokenUrl READ tokenUrl WRITE setTokenUrl NOTIFY tokenUrlChanged)
+	//! The refresh token to obtain new access tokens with
+	Q_PROPERTY(QString refreshToken READ refreshToken WRITE setRefreshToken NOTIFY refreshTokenChanged)
+	//! The OAuth2 client id, sent with refresh requests
+	Q_PROPERTY(QString clientId READ clientId WRITE setClientId NOTIFY clientIdChanged)
+	//! The OAuth2 client secret, sent with refresh requests
+	Q_PROPERTY(QString clientSecret READ clientSecret WRITE setClientSecret NOTIFY clientSecretChanged)
+	//! The time in seconds before the expiry at which the token is refreshed
+	Q_PROPERTY(int refreshMargin READ refreshMargin WRITE setRefreshMargin NOTIFY refreshMarginChanged)
+	//! Specifies, whether a refresh is currently running
+	Q_PROPERTY(bool refreshing READ isRefreshing NOTIFY refreshingChanged)
+
+public:
+	//! The name of the Authorization header
+	static const QByteArray AuthorizationHeader;
+
+	//! Creates an authenticator for the client and adds it to the clients interceptors
+	explicit Authenticator(RestClient *client);
+	~Authenticator();
+
+	//! Returns the client the authenticator is used by
+	RestClient *client() const;
+
+	//! @readAcFn{Authenticator::accessToken}
+	QString accessToken() const;
+	//! @readAcFn{Authenticator::tokenType}
+	QString tokenType() const;
+	//! @readAcFn{Authenticator::expiresAt}
+	QDateTime expiresAt() const;
+	//! @readAcFn{Authenticator::tokenUrl}
+	QUrl tokenUrl() const;
+	//! @readAcFn{Authenticator::refreshToken}
+	QString refreshToken() const;
+	//! @readAcFn{Authenticator::clientId}
+	QString clientId() const;
+	//! @readAcFn{Authenticator::clientSecret}
+	QString clientSecret() const;
+	//! @readAcFn{Authenticator::refreshMargin}
+	int refreshMargin() const;
+	//! @readAcFn{Authenticator::refreshing}
+	bool isRefreshing() const;
+
+	//! Returns the value of the Authorization header for the current access token
+	QByteArray authorization() const;
+
+	//! @inherit{RequestInterceptor::interceptRequest}
+	QNetworkReply *interceptRequest(RequestBuilder &builder) override;
+	//! @inherit{RequestInterceptor::interceptReply}
+	void interceptReply(QNetworkReply *reply, int &status, QByteArray &data) override;
+
+public Q_SLOTS:
+	//! Sets the access token, which expires after the given number of seconds, or never if negative
+	void setAccessToken(const QString &accessToken, int expiresIn = -1);
+	//! Refreshes the access token, unless a refresh is already running
+	void refresh();
+
+	//! @writeAcFn{Authenticator::tokenType}
+	void setTokenType(QString tokenType);
+	//! @writeAcFn{Authenticator::tokenUrl}
+	void setTokenUrl(QUrl tokenUrl);
+	//! @writeAcFn{Authenticator::refreshToken}
+	void setRefreshToken(QString refreshToken);
+	//! @writeAcFn{Authenticator::clientId}
+	void setClientId(QString clientId);
+	//! @writeAcFn{Authenticator::clientSecret}
+	void setClientSecret(QString clientSecret);
+	//! @writeAcFn{Authenticator::refreshMargin}
+	void setRefreshMargin(int refreshMargin);
+
+Q_SIGNALS:
+	//! Is emitted when a refresh failed. Requests that were waiting for it fail with their original reply
+	void refreshFailed(const QString &errorString, QPrivateSignal);
+
+	//! @notifyAcFn{Authenticator::accessToken}
+	void accessTokenChanged(const QString &accessToken, QPrivateSignal);
+	//! @notifyAcFn{Authenticator::tokenType}
+	void tokenTypeChanged(QString tokenType, QPrivateSignal);
+	//! @notifyAcFn{Authenticator::tokenUrl}
+	void tokenUrlChanged(QUrl tokenUrl, QPrivateSignal);
+	//! @notifyAcFn{Authenticator::refreshToken}
+	void refreshTokenChanged(QString refreshToken, QPrivateSignal);
+	//! @notifyAcFn{Authenticator::clientId}
+	void clientIdChanged(QString clientId, QPrivateSignal);
+	//! @notifyAcFn{Authenticator::clientSecret}
+	void clientSecretChanged(QString clientSecret, QPrivateSignal);
+	//! @notifyAcFn{Authenticator::refreshMargin}
+	void refreshMarginChanged(int refreshMargin, QPrivateSignal);
+	//! @notifyAcFn{Authenticator::refreshing}
+	void refreshingChanged(bool refreshing, QPrivateSignal);
+
+protected:
+	//! Starts the refresh of the access token. The default implementation uses the OAuth2 refresh_token grant
+	virtual void startRefresh();
+	//! Completes a running refresh with a new access token
+	void completeRefresh(const QString &accessToken, int expiresIn = -1, const QString &refreshToken = QString());
+	//! Completes a running refresh with an error
+	void failRefresh(const QString &errorString);
+
+private:
+	QScopedPointer<AuthenticatorPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_AUTHENTICATOR_H
@@ -0,0 +1,55 @@
+#ifndef QTRESTCLIENT_AUTHENTICATOR_P_H
+#define QTRESTCLIENT_AUTHENTICATOR_P_H
+
+#include "authenticator.h"
+#include "restclient.h"
+#include "restreply_p.h"
+
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT AuthenticatorPrivate
+{
+	friend class Authenticator;
+
+public:
+	static const QByteArray PropertyReplayed;
+	static const int MinRetryDelay;
+	static const int MaxRetryDelay;
+
+	QPointer<RestClient> client;
+	QString accessToken;
+	QString tokenType;
+	QDateTime expiresAt;
+	QUrl tokenUrl;
+	QString refreshToken;
+	QString clientId;
+	QString clientSecret;
+	int refreshMargin;
+	bool refreshing;
+	int failedRefreshes;
+	QDateTime retryAfter;
+
+	QTimer *refreshTimer;
+	QList<QPointer<RestReplyPrivate>> parkedReplies;
+
+	AuthenticatorPrivate(Authenticator *q_ptr, RestClient *client);
+
+	bool needsRefresh() const;
+	bool isBackingOff() const;
+	void scheduleRefresh();
+	void updateClientHeader();
+	void setRefreshing(bool refreshing);
+	void replayParked(bool resend);
+
+	static QByteArray formEncode(const QList<QPair<QString, QString>> &fields);
+
+private:
+	Authenticator *q;
+};
+
+}
+
+#endif // QTRESTCLIENT_AUTHENTICATOR_P_H
@@ -0,0 +1,398 @@
+#ifndef QTRESTCLIENT_AWAITABLE_H
+#define QTRESTCLIENT_AWAITABLE_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/restreply.h"
+#include "QtRestClient/genericrestreply.h"
+#include "QtRestClient/restreplyexception.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define QTRESTCLIENT_HAS_COROUTINES
+#endif
+#endif
+
+#ifdef QTRESTCLIENT_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace QtRestClient {
+
+namespace Private {
+
+template <typename T>
+struct AwaitState
+{
+	std::optional<T> value;
+	std::exception_ptr exception;
+	std::coroutine_handle<> handle;
+	bool done = false;
+
+	void resume() {
+		if(done)
+			return;
+		done = true;
+		if(handle)
+			handle.resume();
+	}
+};
+
+template <>
+struct AwaitState<void>
+{
+	std::exception_ptr exception;
+	std::coroutine_handle<> handle;
+	bool done = false;
+
+	void resume() {
+		if(done)
+			return;
+		done = true;
+		if(handle)
+			handle.resume();
+	}
+};
+
+template <typename T>
+void connectErrors(RestReply *reply, const std::shared_ptr<AwaitState<T>> &state)
+{
+	QObject::connect(reply, &RestReply::failed, [state](int httpStatus, const QJsonValue &reason) {
+		state->exception = std::make_exception_ptr(RestReplyException(httpStatus, reason));
+		state->resume();
+	});
+	QObject::connect(reply, &RestReply::error, [state](const QString &errorString, int error, RestReply::ErrorType errorType) {
+		state->exception = std::make_exception_ptr(RestReplyException(errorString, error, errorType));
+		state->resume();
+	});
+	//resume the coroutine if the reply is deleted before it completed, to not leak its frame
+	QObject::connect(reply, &QObject::destroyed, [state]() {
+		if(state->done)
+			return;
+		state->exception = std::make_exception_ptr(RestReplyException(QStringLiteral("The reply was destroyed before it completed"),
+																	   QNetworkReply::OperationCanceledError,
+																	   RestReply::NetworkError));
+		state->resume();
+	});
+}
+
+template <typename TReply, typename TState>
+void connectSerializeException(TReply *reply, const std::shared_ptr<TState> &state)
+{
+	reply->onSerializeException([state](QJsonSerializerException &exception) {
+		state->exception = std::make_exception_ptr(RestReplyException(QString::fromUtf8(exception.what()),
+																	   0,
+																	   RestReply::DeserializationError));
+		state->resume();
+	});
+}
+
+}
+
+//! An awaiter that suspends a coroutine until a RestReply has completed
+class ReplyAwaiter
+{
+public:
+	//! Creates an awaiter for the given reply
+	explicit ReplyAwaiter(RestReply *reply) :
+		_state(std::make_shared<Private::AwaitState<QJsonValue>>())
+	{
+		QObject::connect(reply, &RestReply::succeeded, [state = _state](int, const QJsonValue &value) {
+			state->value = value;
+			state->resume();
+		});
+		Private::connectErrors(reply, _state);
+	}
+
+	//! Returns true, if the reply has already completed
+	bool await_ready() const noexcept {
+		return _state->done;
+	}
+	//! Stores the coroutine to be resumed once the reply completes
+	void await_suspend(std::coroutine_handle<> handle) noexcept {
+		_state->handle = handle;
+	}
+	//! Returns the received value, or throws a RestReplyException
+	QJsonValue await_resume() {
+		if(_state->exception)
+			std::rethrow_exception(_state->exception);
+		return std::move(*_state->value);
+	}
+
+private:
+	std::shared_ptr<Private::AwaitState<QJsonValue>> _state;
+};
+
+//! An awaiter that suspends a coroutine until a GenericRestReply has completed
+template <typename DataClassType, typename ErrorClassType>
+class GenericReplyAwaiter
+{
+public:
+	//! @private
+	using AwaitStateType = Private::AwaitState<DataClassType>;
+
+	//! Creates an awaiter for the given reply
+	explicit GenericReplyAwaiter(GenericRestReply<DataClassType, ErrorClassType> *reply) :
+		_state(std::make_shared<AwaitStateType>())
+	{
+		auto state = _state;
+		reply->onSucceeded([state](int, DataClassType value) {
+			state->value = std::move(value);
+			state->resume();
+		});
+		Private::connectErrors(reply, _state);
+		Private::connectSerializeException(reply, _state);
+	}
+
+	//! @copydoc ReplyAwaiter::await_ready
+	bool await_ready() const noexcept {
+		return _state->done;
+	}
+	//! @copydoc ReplyAwaiter::await_suspend
+	void await_suspend(std::coroutine_handle<> handle) noexcept {
+		_state->handle = handle;
+	}
+	//! Returns the deserialized value, or throws a RestReplyException
+	DataClassType await_resume() {
+		if(_state->exception)
+			std::rethrow_exception(_state->exception);
+		return std::move(*_state->value);
+	}
+
+private:
+	std::shared_ptr<AwaitStateType> _state;
+};
+
+//! @copydoc GenericReplyAwaiter
+template <typename ErrorClassType>
+class GenericReplyAwaiter<void, ErrorClassType>
+{
+public:
+	//! @private
+	using AwaitStateType = Private::AwaitState<void>;
+
+	//! @copydoc GenericReplyAwaiter::GenericReplyAwaiter
+	explicit GenericReplyAwaiter(GenericRestReply<void, ErrorClassType> *reply) :
+		_state(std::make_shared<AwaitStateType>())
+	{
+		auto state = _state;
+		reply->onSucceeded([state](int) {
+			state->resume();
+		});
+		Private::connectErrors(reply, _state);
+		Private::connectSerializeException(reply, _state);
+	}
+
+	//! @copydoc ReplyAwaiter::await_ready
+	bool await_ready() const noexcept {
+		return _state->done;
+	}
+	//! @copydoc ReplyAwaiter::await_suspend
+	void await_suspend(std::coroutine_handle<> handle) noexcept {
+		_state->handle = handle;
+	}
+	//! Throws a RestReplyException, if the reply did not succeed
+	void await_resume() {
+		if(_state->exception)
+			std::rethrow_exception(_state->exception);
+	}
+
+private:
+	std::shared_ptr<AwaitStateType> _state;
+};
+
+//! Creates an awaiter for a reply, to be used with `co_await` in any coroutine type
+inline ReplyAwaiter awaitReply(RestReply *reply)
+{
+	return ReplyAwaiter(reply);
+}
+
+//! @copydoc awaitReply(RestReply *)
+template <typename DataClassType, typename ErrorClassType>
+inline GenericReplyAwaiter<DataClassType, ErrorClassType> awaitReply(GenericRestReply<DataClassType, ErrorClassType> *reply)
+{
+	return GenericReplyAwaiter<DataClassType, ErrorClassType>(reply);
+}
+
+namespace Private {
+
+class TaskPromiseBase
+{
+public:
+	std::exception_ptr exception;
+	std::coroutine_handle<> continuation;
+	bool detached = false;
+
+	struct FinalAwaiter {
+		TaskPromiseBase *promise;
+
+		bool await_ready() const noexcept {
+			return promise->detached;
+		}
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept {
+			if(promise->continuation)
+				return promise->continuation;
+			else
+				return std::noop_coroutine();
+		}
+		void await_resume() const noexcept {}
+	};
+
+	std::suspend_never initial_suspend() const noexcept {
+		return {};
+	}
+	FinalAwaiter final_suspend() noexcept {
+		return FinalAwaiter{this};
+	}
+	void unhandled_exception() noexcept {
+		exception = std::current_exception();
+	}
+
+	ReplyAwaiter await_transform(RestReply *reply) {
+		return ReplyAwaiter(reply);
+	}
+	template <typename DataClassType, typename ErrorClassType>
+	GenericReplyAwaiter<DataClassType, ErrorClassType> await_transform(GenericRestReply<DataClassType, ErrorClassType> *reply) {
+		return GenericReplyAwaiter<DataClassType, ErrorClassType>(reply);
+	}
+	template <typename TAwaitable>
+	TAwaitable &&await_transform(TAwaitable &&awaitable) noexcept {
+		return std::forward<TAwaitable>(awaitable);
+	}
+};
+
+template <typename TPromise>
+struct TaskAwaiter
+{
+	std::coroutine_handle<TPromise> handle;
+
+	bool await_ready() const noexcept {
+		return handle.done();
+	}
+	void await_suspend(std::coroutine_handle<> continuation) noexcept {
+		handle.promise().continuation = continuation;
+	}
+	auto await_resume() {
+		auto &promise = handle.promise();
+		if(promise.exception)
+			std::rethrow_exception(promise.exception);
+		return promise.result();
+	}
+};
+
+}
+
+//! A coroutine type that can directly `co_await` replies
+template <typename T = void>
+class Task
+{
+public:
+	//! @private
+	class promise_type : public Private::TaskPromiseBase
+	{
+	public:
+		std::optional<T> value;
+
+		Task get_return_object() {
+			return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		void return_value(T result) {
+			value = std::move(result);
+		}
+		T result() {
+			return std::move(*value);
+		}
+	};
+
+	//! Move constructor
+	Task(Task &&other) noexcept :
+		_handle(std::exchange(other._handle, nullptr))
+	{}
+	//! Destroys the task. A still running coroutine continues detached
+	~Task() {
+		if(!_handle)
+			return;
+		if(_handle.done())
+			_handle.destroy();
+		else
+			_handle.promise().detached = true;
+	}
+
+	//! Returns true, if the coroutine has completed
+	bool isFinished() const {
+		return !_handle || _handle.done();
+	}
+
+	//! Suspends the awaiting coroutine until this one has completed, and returns its value
+	Private::TaskAwaiter<promise_type> operator co_await() const noexcept {
+		return Private::TaskAwaiter<promise_type>{_handle};
+	}
+
+private:
+	std::coroutine_handle<promise_type> _handle;
+
+	explicit Task(std::coroutine_handle<promise_type> handle) :
+		_handle(handle)
+	{}
+	Task(const Task &other) = delete;
+	Task &operator=(const Task &other) = delete;
+};
+
+//! @copydoc Task
+template <>
+class Task<void>
+{
+public:
+	//! @private
+	class promise_type : public Private::TaskPromiseBase
+	{
+	public:
+		Task get_return_object() {
+			return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		void return_void() noexcept {}
+		void result() noexcept {}
+	};
+
+	//! @copydoc Task::Task(Task &&)
+	Task(Task &&other) noexcept :
+		_handle(std::exchange(other._handle, nullptr))
+	{}
+	//! @copydoc Task::~Task
+	~Task() {
+		if(!_handle)
+			return;
+		if(_handle.done())
+			_handle.destroy();
+		else
+			_handle.promise().detached = true;
+	}
+
+	//! @copydoc Task::isFinished
+	bool isFinished() const {
+		return !_handle || _handle.done();
+	}
+
+	//! @copydoc Task::operator co_await
+	Private::TaskAwaiter<promise_type> operator co_await() const noexcept {
+		return Private::TaskAwaiter<promise_type>{_handle};
+	}
+
+private:
+	std::coroutine_handle<promise_type> _handle;
+
+	explicit Task(std::coroutine_handle<promise_type> handle) :
+		_handle(handle)
+	{}
+	Task(const Task &other) = delete;
+	Task &operator=(const Task &other) = delete;
+};
+
+}
+
+#endif // QTRESTCLIENT_HAS_COROUTINES
+
+#endif // QTRESTCLIENT_AWAITABLE_H
@@ -0,0 +1,170 @@
+#include "cursorpaging.h"
+
+#include <QtCore/QUrlQuery>
+#include <QtNetwork/QNetworkReply>
+#include <QtJsonSerializer/QJsonSerializerException>
+using namespace QtRestClient;
+
+namespace QtRestClient {
+
+class CursorPagingFactoryPrivate
+{
+public:
+	CursorPagingFactoryPrivate(const QString &cursorParameter,
+							   const QString &nextCursorKey,
+							   const QString &previousCursorKey,
+							   const QString &itemsKey);
+
+	QString cursorParameter;
+	QString nextCursorKey;
+	QString previousCursorKey;
+	QString itemsKey;
+
+	static QString readCursor(const QJsonObject &data, const QString &key);
+	QUrl cursorUrl(const QUrl &url, const QString &cursor) const;
+};
+
+class CursorPaging : public IPaging
+{
+public:
+	CursorPaging(const QJsonObject &json, const QString &itemsKey, const QUrl &next, const QUrl &previous);
+
+	QJsonArray items() const override;
+	int total() const override;
+	bool hasNext() const override;
+	QUrl next() const override;
+	bool hasPrevious() const override;
+	QUrl previous() const override;
+	QVariantMap properties() const override;
+	QJsonObject originalJson() const override;
+
+private:
+	QJsonObject _json;
+	QString _itemsKey;
+	QUrl _next;
+	QUrl _previous;
+
+	mutable bool _hasProperties;
+	mutable QVariantMap _properties;
+};
+
+}
+
+CursorPagingFactory::CursorPagingFactory(const QString &cursorParameter, const QString &nextCursorKey, const QString &previousCursorKey, const QString &itemsKey) :
+	PagingFactory(),
+	d(new CursorPagingFactoryPrivate(cursorParameter, nextCursorKey, previousCursorKey, itemsKey))
+{}
+
+CursorPagingFactory::~CursorPagingFactory() {}
+
+IPaging *CursorPagingFactory::createPaging(QJsonSerializer *serializer, const QJsonObject &data) const
+{
+	return createPagingFromReply(serializer, QJsonValue(data), nullptr);
+}
+
+IPaging *CursorPagingFactory::createPagingFromReply(QJsonSerializer *serializer, const QJsonValue &data, const QNetworkReply *reply) const
+{
+	Q_UNUSED(serializer)
+
+	auto json = data.toObject();
+	if(!data.isObject() || !json.value(d->itemsKey).isArray())
+		throw QJsonDeserializationException("Given JSON is not an object with items!");
+
+	//the cursors are passed to the URL that returned this page
+	QUrl next;
+	QUrl previous;
+	if(reply) {
+		next = d->cursorUrl(reply->url(), CursorPagingFactoryPrivate::readCursor(json, d->nextCursorKey));
+		if(!d->previousCursorKey.isEmpty())
+			previous = d->cursorUrl(reply->url(), CursorPagingFactoryPrivate::readCursor(json, d->previousCursorKey));
+	}
+	return new CursorPaging(json, d->itemsKey, next, previous);
+}
+
+CursorPaging::CursorPaging(const QJsonObject &json, const QString &itemsKey, const QUrl &next, const QUrl &previous) :
+	IPaging(),
+	_json(json),
+	_itemsKey(itemsKey),
+	_next(next),
+	_previous(previous),
+	_hasProperties(false),
+	_properties()
+{}
+
+QJsonArray CursorPaging::items() const
+{
+	return _json.value(_itemsKey).toArray();
+}
+
+int CursorPaging::total() const
+{
+	return _json.value(QStringLiteral("total")).toInt(INT_MAX);
+}
+
+bool CursorPaging::hasNext() const
+{
+	return _next.isValid();
+}
+
+QUrl CursorPaging::next() const
+{
+	return _next;
+}
+
+bool CursorPaging::hasPrevious() const
+{
+	return _previous.isValid();
+}
+
+QUrl CursorPaging::previous() const
+{
+	return _previous;
+}
+
+QVariantMap CursorPaging::properties() const
+{
+	if(!_hasProperties) {
+		_properties = _json.toVariantMap();
+		_hasProperties = true;
+	}
+	return _properties;
+}
+
+QJsonObject CursorPaging::originalJson() const
+{
+	return _json;
+}
+
+// ------------- Private Implementation -------------
+
+CursorPagingFactoryPrivate::CursorPagingFactoryPrivate(const QString &cursorParameter, const QString &nextCursorKey, const QString &previousCursorKey, const QString &itemsKey) :
+	cursorParameter(cursorParameter),
+	nextCursorKey(nextCursorKey),
+	previousCursorKey(previousCursorKey),
+	itemsKey(itemsKey)
+{}
+
+QString CursorPagingFactoryPrivate::readCursor(const QJsonObject &data, const QString &key)
+{
+	auto value = data.value(key);
+	if(value.isString())
+		return value.toString();
+	else if(value.isDouble())
+		return value.toVariant().toString();
+	else
+		return {};
+}
+
+QUrl CursorPagingFactoryPrivate::cursorUrl(const QUrl &url, const QString &cursor) const
+{
+	if(cursor.isEmpty())
+		return {};
+
+	QUrlQuery query(url);
+	query.removeAllQueryItems(cursorParameter);
+	//cursors are opaque -> encode everything, including '+' and '='
+	query.addQueryItem(cursorParameter, QString::fromUtf8(QUrl::toPercentEncoding(cursor)));
+	auto cursorUrl = url;
+	cursorUrl.setQuery(query);
+	return cursorUrl;
+}
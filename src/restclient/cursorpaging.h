@@ -0,0 +1,32 @@
+#ifndef QTRESTCLIENT_CURSORPAGING_H
+#define QTRESTCLIENT_CURSORPAGING_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/ipaging.h"
+
+#include <QtCore/qscopedpointer.h>
+
+namespace QtRestClient {
+
+class CursorPagingFactoryPrivate;
+//! A paging factory for APIs that return an opaque cursor to pass with the request for the next page
+class Q_RESTCLIENT_EXPORT CursorPagingFactory : public PagingFactory
+{
+public:
+	//! Creates a factory for the given query parameter and JSON keys
+	CursorPagingFactory(const QString &cursorParameter = QStringLiteral("cursor"),
+						const QString &nextCursorKey = QStringLiteral("nextCursor"),
+						const QString &previousCursorKey = QStringLiteral("previousCursor"),
+						const QString &itemsKey = QStringLiteral("items"));
+	~CursorPagingFactory() override;
+
+	IPaging *createPaging(QJsonSerializer *serializer, const QJsonObject &data) const override;
+	IPaging *createPagingFromReply(QJsonSerializer *serializer, const QJsonValue &data, const QNetworkReply *reply) const override;
+
+private:
+	QScopedPointer<CursorPagingFactoryPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_CURSORPAGING_H
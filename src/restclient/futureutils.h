@@ -0,0 +1,268 @@
+#ifndef QTRESTCLIENT_FUTUREUTILS_H
+#define QTRESTCLIENT_FUTUREUTILS_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <QtCore/qexception.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qfuturewatcher.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qvector.h>
+#include <functional>
+
+namespace QtRestClient {
+
+namespace Private {
+
+template <typename T>
+struct FutureResult;
+
+template <typename T>
+struct FutureResult<QFuture<T>> {
+	using type = T;
+};
+
+template <typename T>
+struct WhenAllState
+{
+	QFutureInterface<QList<T>> futureInterface;
+	QVector<T> results;
+	int pending;
+};
+
+template <>
+struct WhenAllState<void>
+{
+	QFutureInterface<void> futureInterface;
+	int pending;
+};
+
+template <typename T>
+struct WhenAnyState
+{
+	QFutureInterface<T> futureInterface;
+	int count;
+	int remaining;
+	int done;
+};
+
+template <typename TIn, typename TOut, typename TFunc>
+struct MapState
+{
+	QFutureInterface<TOut> futureInterface;
+	QList<TIn> inputs;
+	TFunc func;
+	int maxConcurrent;
+	int next;
+	int done;
+	QHash<int, QFuture<TOut>> running;
+};
+
+template <typename T, typename TResult>
+bool checkFuture(QFuture<T> future, QFutureInterface<TResult> &futureInterface)
+{
+	if(!future.isCanceled())
+		return true;
+	try {
+		future.waitForFinished();
+		futureInterface.cancel();
+	} catch(QException &e) {
+		futureInterface.reportException(e);
+	}
+	futureInterface.reportFinished();
+	return false;
+}
+
+template <typename T, typename TResult>
+void cancelOnCancel(const QFuture<TResult> &future, std::function<QList<QFuture<T>>()> inputs)
+{
+	auto watcher = new QFutureWatcher<TResult>();
+	QObject::connect(watcher, &QFutureWatcherBase::canceled, watcher, [inputs](){
+		for(auto future : inputs())
+			future.cancel();
+	});
+	QObject::connect(watcher, &QFutureWatcherBase::finished,
+					 watcher, &QFutureWatcherBase::deleteLater);
+	watcher->setFuture(future);
+}
+
+template <typename TIn, typename TOut, typename TFunc>
+void mapNext(const QSharedPointer<MapState<TIn, TOut, TFunc>> &state)
+{
+	while(state->running.size() < state->maxConcurrent &&
+		  state->next < state->inputs.size() &&
+		  !state->futureInterface.isCanceled()) {
+		auto index = state->next++;
+		auto future = state->func(state->inputs[index]);
+		state->running.insert(index, future);
+
+		auto watcher = new QFutureWatcher<TOut>();
+		QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [state, watcher, index](){
+			watcher->deleteLater();
+			state->running.remove(index);
+			if(state->futureInterface.isFinished())
+				return;
+			if(state->futureInterface.isCanceled()) {
+				if(state->running.isEmpty())
+					state->futureInterface.reportFinished();
+				return;
+			}
+			if(!checkFuture(watcher->future(), state->futureInterface))
+				return;
+
+			state->futureInterface.reportResult(watcher->result(), index);
+			state->futureInterface.setProgressValue(++state->done);
+			if(state->done == state->inputs.size())
+				state->futureInterface.reportFinished();
+			else
+				mapNext(state);
+		});
+		watcher->setFuture(future);
+	}
+}
+
+}
+
+//! Returns a future that finishes with the results of all futures, or the first exception of them
+template <typename T>
+QFuture<QList<T>> whenAll(const QList<QFuture<T>> &futures)
+{
+	QSharedPointer<Private::WhenAllState<T>> state(new Private::WhenAllState<T>());
+	state->futureInterface.reportStarted();
+	state->results.resize(futures.size());
+	state->pending = futures.size();
+	if(futures.isEmpty()) {
+		QList<T> results;
+		state->futureInterface.reportFinished(&results);
+		return state->futureInterface.future();
+	}
+
+	for(auto i = 0; i < futures.size(); i++) {
+		auto watcher = new QFutureWatcher<T>();
+		QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [state, watcher, i](){
+			watcher->deleteLater();
+			if(state->futureInterface.isFinished() ||
+			   !Private::checkFuture(watcher->future(), state->futureInterface))
+				return;
+			state->results[i] = watcher->result();
+			if(--state->pending == 0) {
+				auto results = state->results.toList();
+				state->futureInterface.reportFinished(&results);
+			}
+		});
+		watcher->setFuture(futures[i]);
+	}
+
+	Private::cancelOnCancel<T>(state->futureInterface.future(), [futures](){
+		return futures;
+	});
+	return state->futureInterface.future();
+}
+
+//! @copydoc whenAll(const QList<QFuture<T>> &)
+inline QFuture<void> whenAll(const QList<QFuture<void>> &futures)
+{
+	QSharedPointer<Private::WhenAllState<void>> state(new Private::WhenAllState<void>());
+	state->futureInterface.reportStarted();
+	state->pending = futures.size();
+	if(futures.isEmpty()) {
+		state->futureInterface.reportFinished();
+		return state->futureInterface.future();
+	}
+
+	for(const auto &future : futures) {
+		auto watcher = new QFutureWatcher<void>();
+		QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [state, watcher](){
+			watcher->deleteLater();
+			if(state->futureInterface.isFinished() ||
+			   !Private::checkFuture(watcher->future(), state->futureInterface))
+				return;
+			if(--state->pending == 0)
+				state->futureInterface.reportFinished();
+		});
+		watcher->setFuture(future);
+	}
+
+	Private::cancelOnCancel<void>(state->futureInterface.future(), [futures](){
+		return futures;
+	});
+	return state->futureInterface.future();
+}
+
+//! Returns a future that finishes with the results of the first count futures that succeeded
+template <typename T>
+QFuture<T> whenAny(const QList<QFuture<T>> &futures, int count = 1)
+{
+	QSharedPointer<Private::WhenAnyState<T>> state(new Private::WhenAnyState<T>());
+	state->futureInterface.reportStarted();
+	state->count = count;
+	state->remaining = futures.size();
+	state->done = 0;
+	if(futures.size() < count)
+		state->futureInterface.cancel();
+	if(count <= 0 || futures.size() < count) {
+		state->futureInterface.reportFinished();
+		return state->futureInterface.future();
+	}
+
+	for(const auto &future : futures) {
+		auto watcher = new QFutureWatcher<T>();
+		QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [state, watcher](){
+			watcher->deleteLater();
+			state->remaining--;
+			if(state->futureInterface.isFinished())
+				return;
+			if(watcher->isCanceled()) {
+				// fails only once too few futures are left to reach the count
+				if(state->done + state->remaining < state->count)
+					Private::checkFuture(watcher->future(), state->futureInterface);
+				return;
+			}
+			state->futureInterface.reportResult(watcher->result());
+			if(++state->done == state->count)
+				state->futureInterface.reportFinished();
+		});
+		watcher->setFuture(future);
+	}
+
+	Private::cancelOnCancel<T>(state->futureInterface.future(), [futures](){
+		return futures;
+	});
+	return state->futureInterface.future();
+}
+
+//! Calls func for every input, with at most maxConcurrent of the returned futures running at once
+template <typename TIn, typename TFunc>
+auto mapConcurrent(const QList<TIn> &inputs, int maxConcurrent, TFunc func) -> decltype(func(inputs.first()))
+{
+	using TOut = typename Private::FutureResult<decltype(func(inputs.first()))>::type;
+	QSharedPointer<Private::MapState<TIn, TOut, TFunc>> state(new Private::MapState<TIn, TOut, TFunc> {
+		QFutureInterface<TOut>(),
+		inputs,
+		func,
+		qMax(1, maxConcurrent),
+		0,
+		0,
+		{}
+	});
+	state->futureInterface.reportStarted();
+	state->futureInterface.setProgressRange(0, inputs.size());
+	if(inputs.isEmpty()) {
+		state->futureInterface.reportFinished();
+		return state->futureInterface.future();
+	}
+
+	QWeakPointer<Private::MapState<TIn, TOut, TFunc>> weakState = state;
+	Private::cancelOnCancel<TOut>(state->futureInterface.future(), [weakState](){
+		auto state = weakState.toStrongRef();
+		return state ? state->running.values() : QList<QFuture<TOut>>();
+	});
+	Private::mapNext(state);
+	return state->futureInterface.future();
+}
+
+}
+
+#endif // QTRESTCLIENT_FUTUREUTILS_H
@@ -6,12 +6,40 @@
 #include "QtRestClient/restreply.h"
 #include "QtRestClient/paging_fwd.h"
 #include "QtRestClient/metacomponent.h"
+#include "QtRestClient/pagecache.h"
+#include "QtRestClient/restreplyexception.h"
 
+#include <QtCore/qfuture.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qfuturewatcher.h>
 #include <QtJsonSerializer/qjsonserializer.h>
 #include <type_traits>
 
 namespace QtRestClient {
 
+namespace Private {
+
+template <typename T>
+void connectFuture(RestReply *reply, QFutureInterface<T> futureInterface)
+{
+	futureInterface.reportStarted();
+	QObject::connect(reply, &RestReply::failed, reply, [=](int httpStatus, const QJsonValue &reason) mutable {
+		futureInterface.reportException(RestReplyException(httpStatus, reason));
+		futureInterface.reportFinished();
+	});
+	QObject::connect(reply, &RestReply::error, reply, [=](const QString &errorString, int error, RestReply::ErrorType errorType) mutable {
+		futureInterface.reportException(RestReplyException(errorString, error, errorType));
+		futureInterface.reportFinished();
+	});
+
+	auto watcher = new QFutureWatcher<T>(reply);
+	QObject::connect(watcher, &QFutureWatcherBase::canceled,
+					 reply, &RestReply::abort);
+	watcher->setFuture(futureInterface.future());
+}
+
+}
+
 //! A class to handle generic replies for generic requests
 template <typename DataClassType, typename ErrorClassType = QObject*>
 class GenericRestReply : public RestReply
@@ -42,6 +70,9 @@ public:
 	//! @copydoc RestReply::disableAutoDelete
 	GenericRestReply<DataClassType, ErrorClassType> *disableAutoDelete();
 
+	//! Returns a future that finishes with the deserialized result, or a RestReplyException
+	QFuture<DataClassType> toFuture();
+
 private:
 	RestClient *client;
 	std::function<void(QJsonSerializerException &)> exceptionHandler;
@@ -78,6 +109,9 @@ public:
 	//! @copydoc GenericRestReply::disableAutoDelete
 	GenericRestReply<void, ErrorClassType> *disableAutoDelete();
 
+	//! @copydoc GenericRestReply::toFuture
+	QFuture<void> toFuture();
+
 private:
 	RestClient *client;
 	std::function<void(QJsonSerializerException &)> exceptionHandler;
@@ -116,6 +150,9 @@ public:
 	//! @copydoc GenericRestReply::disableAutoDelete
 	GenericRestReply<QList<DataClassType>, ErrorClassType> *disableAutoDelete();
 
+	//! @copydoc GenericRestReply::toFuture
+	QFuture<QList<DataClassType>> toFuture();
+
 private:
 	RestClient *client;
 	std::function<void(QJsonSerializerException &)> exceptionHandler;
@@ -149,6 +186,8 @@ public:
 
 	//! shortcut to iterate over all elements via paging objects
 	GenericRestReply<Paging<DataClassType>, ErrorClassType> *iterate(std::function<bool(DataClassType, int)> iterator, int to = -1, int from = 0);
+	//! shortcut to collect all elements of all paging objects into one list
+	GenericRestReply<Paging<DataClassType>, ErrorClassType> *collect(std::function<void(QList<DataClassType>, bool)> handler, int maxItems = -1, qint64 maxBytes = -1);
 
 	//overshadowing, for the right return type only..
 	//! @copydoc GenericRestReply::onCompleted
@@ -158,8 +197,16 @@ public:
 	//! @copydoc GenericRestReply::disableAutoDelete
 	GenericRestReply<Paging<DataClassType>, ErrorClassType> *disableAutoDelete();
 
+	//! @copydoc GenericRestReply::toFuture
+	QFuture<Paging<DataClassType>> toFuture();
+
 private:
+	friend class Paging<DataClassType>;
+
 	RestClient *client;
+	QUrl cacheUrl;
+	Paging<DataClassType> cachedPaging;
+	QList<QPointer<QObject>> cachedGuards;
 	std::function<void(int, ErrorClassType)> failureHandler;
 	std::function<void(QString, int, ErrorType)> errorHandler;
 	std::function<void(QJsonSerializerException &)> exceptionHandler;
@@ -190,7 +237,9 @@ GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType,
 		try {
 			if(!value.isObject())
 				throw QJsonDeserializationException("Expected JSON object but got " + jsonTypeName(value.type()));
-			handler(code, client->serializer()->deserialize<DataClassType>(value.toObject()));
+			auto data = client->serializer()->deserialize<DataClassType>(value.toObject());
+			this->recordPhase(RequestMetrics::Deserialized);
+			handler(code, data);
 		} catch(QJsonSerializerException &e) {
 			if(exceptionHandler)
 				exceptionHandler(e);
@@ -208,7 +257,9 @@ GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType,
 		try {
 			if(!value.isObject())
 				throw QJsonDeserializationException("Expected JSON object but got " + jsonTypeName(value.type()));
-			handler(code, client->serializer()->deserialize<ErrorClassType>(value.toObject()));
+			auto data = client->serializer()->deserialize<ErrorClassType>(value.toObject());
+			this->recordPhase(RequestMetrics::Deserialized);
+			handler(code, data);
 		} catch(QJsonSerializerException &e) {
 			if(exceptionHandler)
 				exceptionHandler(e);
@@ -220,7 +271,15 @@ GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType,
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType, ErrorClassType>::onSerializeException(std::function<void (QJsonSerializerException &)> handler)
 {
-	exceptionHandler = handler;
+	if(!handler)
+		return this;
+	//handlers are called in the order they were added, like the signal based ones
+	auto previousHandler = exceptionHandler;
+	exceptionHandler = [previousHandler, handler](QJsonSerializerException &exception) {
+		if(previousHandler)
+			previousHandler(exception);
+		handler(exception);
+	};
 	return this;
 }
 
@@ -262,6 +321,21 @@ GenericRestReply<DataClassType, ErrorClassType> *GenericRestReply<DataClassType,
 	return this;
 }
 
+template<typename DataClassType, typename ErrorClassType>
+QFuture<DataClassType> GenericRestReply<DataClassType, ErrorClassType>::toFuture()
+{
+	QFutureInterface<DataClassType> futureInterface;
+	Private::connectFuture(this, futureInterface);
+	onSucceeded([=](int, DataClassType data) mutable {
+		futureInterface.reportFinished(&data);
+	});
+	onSerializeException([=](QJsonSerializerException &exception) mutable {
+		futureInterface.reportException(RestReplyException(QString::fromUtf8(exception.what()), 0, DeserializationError));
+		futureInterface.reportFinished();
+	});
+	return futureInterface.future();
+}
+
 // ------------- Implementation void -------------
 
 template<typename ErrorClassType>
@@ -291,7 +365,9 @@ GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::
 		try {
 			if(!value.isObject())
 				throw QJsonDeserializationException("Expected JSON object but got " + jsonTypeName(value.type()));
-			handler(code, client->serializer()->deserialize<ErrorClassType>(value.toObject()));
+			auto data = client->serializer()->deserialize<ErrorClassType>(value.toObject());
+			this->recordPhase(RequestMetrics::Deserialized);
+			handler(code, data);
 		} catch(QJsonSerializerException &e) {
 			if(exceptionHandler)
 				exceptionHandler(e);
@@ -303,7 +379,15 @@ GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::
 template<typename ErrorClassType>
 GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::onSerializeException(std::function<void (QJsonSerializerException &)> handler)
 {
-	exceptionHandler = handler;
+	if(!handler)
+		return this;
+	//handlers are called in the order they were added, like the signal based ones
+	auto previousHandler = exceptionHandler;
+	exceptionHandler = [previousHandler, handler](QJsonSerializerException &exception) {
+		if(previousHandler)
+			previousHandler(exception);
+		handler(exception);
+	};
 	return this;
 }
 
@@ -345,6 +429,21 @@ GenericRestReply<void, ErrorClassType> *GenericRestReply<void, ErrorClassType>::
 	return this;
 }
 
+template<typename ErrorClassType>
+QFuture<void> GenericRestReply<void, ErrorClassType>::toFuture()
+{
+	QFutureInterface<void> futureInterface;
+	Private::connectFuture(this, futureInterface);
+	onSucceeded([=](int) mutable {
+		futureInterface.reportFinished();
+	});
+	onSerializeException([=](QJsonSerializerException &exception) mutable {
+		futureInterface.reportException(RestReplyException(QString::fromUtf8(exception.what()), 0, DeserializationError));
+		futureInterface.reportFinished();
+	});
+	return futureInterface.future();
+}
+
 // ------------- Implementation List of Elements -------------
 
 template<typename DataClassType, typename ErrorClassType>
@@ -363,7 +462,9 @@ GenericRestReply<QList<DataClassType>, ErrorClassType> *GenericRestReply<QList<D
 		try {
 			if(!value.isArray())
 				throw QJsonDeserializationException("Expected JSON array but got " + jsonTypeName(value.type()));
-			handler(code, client->serializer()->deserialize<QList<DataClassType>>(value.toArray()));
+			auto data = client->serializer()->deserialize<QList<DataClassType>>(value.toArray());
+			this->recordPhase(RequestMetrics::Deserialized);
+			handler(code, data);
 		} catch(QJsonSerializerException &e) {
 			if(exceptionHandler)
 				exceptionHandler(e);
@@ -381,7 +482,9 @@ GenericRestReply<QList<DataClassType>, ErrorClassType> *GenericRestReply<QList<D
 		try {
 			if(!value.isObject())
 				throw QJsonDeserializationException("Expected JSON object but got " + jsonTypeName(value.type()));
-			handler(code, client->serializer()->deserialize<ErrorClassType>(value.toObject()));
+			auto data = client->serializer()->deserialize<ErrorClassType>(value.toObject());
+			this->recordPhase(RequestMetrics::Deserialized);
+			handler(code, data);
 		} catch(QJsonSerializerException &e) {
 			if(exceptionHandler)
 				exceptionHandler(e);
@@ -393,7 +496,15 @@ GenericRestReply<QList<DataClassType>, ErrorClassType> *GenericRestReply<QList<D
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReply<QList<DataClassType>, ErrorClassType> *GenericRestReply<QList<DataClassType>, ErrorClassType>::onSerializeException(std::function<void (QJsonSerializerException &)> handler)
 {
-	exceptionHandler = handler;
+	if(!handler)
+		return this;
+	//handlers are called in the order they were added, like the signal based ones
+	auto previousHandler = exceptionHandler;
+	exceptionHandler = [previousHandler, handler](QJsonSerializerException &exception) {
+		if(previousHandler)
+			previousHandler(exception);
+		handler(exception);
+	};
 	return this;
 }
 
@@ -435,12 +546,30 @@ GenericRestReply<QList<DataClassType>, ErrorClassType> *GenericRestReply<QList<D
 	return this;
 }
 
+template<typename DataClassType, typename ErrorClassType>
+QFuture<QList<DataClassType>> GenericRestReply<QList<DataClassType>, ErrorClassType>::toFuture()
+{
+	QFutureInterface<QList<DataClassType>> futureInterface;
+	Private::connectFuture(this, futureInterface);
+	onSucceeded([=](int, QList<DataClassType> data) mutable {
+		futureInterface.reportFinished(&data);
+	});
+	onSerializeException([=](QJsonSerializerException &exception) mutable {
+		futureInterface.reportException(RestReplyException(QString::fromUtf8(exception.what()), 0, DeserializationError));
+		futureInterface.reportFinished();
+	});
+	return futureInterface.future();
+}
+
 // ------------- Implementation Paging of Elements -------------
 
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReply<Paging<DataClassType>, ErrorClassType>::GenericRestReply(QNetworkReply *networkReply, RestClient *client, QObject *parent) :
 	RestReply(networkReply, parent),
 	client(client),
+	cacheUrl(),
+	cachedPaging(),
+	cachedGuards(),
 	exceptionHandler()
 {}
 
@@ -450,12 +579,20 @@ GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging
 	if(!handler)
 		return this;
 	connect(this, &RestReply::succeeded, this, [=](int code, const QJsonValue &value){
+		//items deleted after the request was answered from the cache were loaded again
+		if(cachedPaging.isValid() && PageCacheEntry::isAlive(cachedGuards)) {
+			handler(code, cachedPaging);
+			return;
+		}
+
 		try {
-			if(!value.isObject())
-				throw QJsonDeserializationException("Expected JSON object but got " + jsonTypeName(value.type()));
-			auto iPaging = client->pagingFactory()->createPaging(client->serializer(), value.toObject());
+			auto iPaging = client->pagingFactory()->createPagingFromReply(client->serializer(), value, networkReply());
 			auto data = client->serializer()->deserialize<QList<DataClassType>>(iPaging->items());
-			handler(code, Paging<DataClassType>(iPaging, data, client));
+			this->recordPhase(RequestMetrics::Deserialized);
+			Paging<DataClassType> paging(iPaging, data, client);
+			if(cacheUrl.isValid() && client->pageCache())
+				client->pageCache()->insert(cacheUrl, paging);
+			handler(code, paging);
 		} catch(QJsonSerializerException &e) {
 			if(exceptionHandler)
 				exceptionHandler(e);
@@ -474,7 +611,9 @@ GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging
 		try {
 			if(!value.isObject())
 				throw QJsonDeserializationException("Expected JSON object but got " + jsonTypeName(value.type()));
-			handler(code, client->serializer()->deserialize<ErrorClassType>(value.toObject()));
+			auto data = client->serializer()->deserialize<ErrorClassType>(value.toObject());
+			this->recordPhase(RequestMetrics::Deserialized);
+			handler(code, data);
 		} catch(QJsonSerializerException &e) {
 			if(exceptionHandler)
 				exceptionHandler(e);
@@ -486,7 +625,15 @@ GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging<DataClassType>, ErrorClassType>::onSerializeException(std::function<void (QJsonSerializerException &)> handler)
 {
-	exceptionHandler = handler;
+	if(!handler)
+		return this;
+	//handlers are called in the order they were added, like the signal based ones
+	auto previousHandler = exceptionHandler;
+	exceptionHandler = [previousHandler, handler](QJsonSerializerException &exception) {
+		if(previousHandler)
+			previousHandler(exception);
+		handler(exception);
+	};
 	return this;
 }
 
@@ -531,6 +678,25 @@ GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging
 	});
 }
 
+/*!
+@param handler The handler to be called with all collected elements
+@param maxItems The maximum number of elements to collect (-1 means no limit)
+@param maxBytes The number of received bytes after which no more pages are requested (-1 means no limit)
+
+This method is a shortcut that waits for the reply to succeed and then collects the elements of the paging object.
+Other than Paging::collectAll, the size of this reply is counted towards `maxBytes` as well. Errors of the following
+pages are passed to the error handler of this reply.
+
+@sa Paging::collectAll
+*/
+template<typename DataClassType, typename ErrorClassType>
+GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging<DataClassType>, ErrorClassType>::collect(std::function<void (QList<DataClassType>, bool)> handler, int maxItems, qint64 maxBytes)
+{
+	return onSucceeded([=](int, Paging<DataClassType> paging){
+		paging.template startCollect<ErrorClassType>(handler, errorHandler, maxItems, maxBytes, this->metrics().bytesReceived());
+	});
+}
+
 template<typename DataClassType, typename ErrorClassType>
 GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging<DataClassType>, ErrorClassType>::onCompleted(std::function<void (int)> handler)
 {
@@ -553,6 +719,21 @@ GenericRestReply<Paging<DataClassType>, ErrorClassType> *GenericRestReply<Paging
 	return this;
 }
 
+template<typename DataClassType, typename ErrorClassType>
+QFuture<Paging<DataClassType>> GenericRestReply<Paging<DataClassType>, ErrorClassType>::toFuture()
+{
+	QFutureInterface<Paging<DataClassType>> futureInterface;
+	Private::connectFuture(this, futureInterface);
+	onSucceeded([=](int, Paging<DataClassType> data) mutable {
+		futureInterface.reportFinished(&data);
+	});
+	onSerializeException([=](QJsonSerializerException &exception) mutable {
+		futureInterface.reportException(RestReplyException(QString::fromUtf8(exception.what()), 0, DeserializationError));
+		futureInterface.reportFinished();
+	});
+	return futureInterface.future();
+}
+
 }
 
 #endif // QTRESTCLIENT_GENERICRESTREPLY_H
@@ -1,4 +1,8 @@
 #include "ipaging.h"
+
+#include <QtCore/QUrlQuery>
+#include <QtJsonSerializer/QJsonSerializerException>
+
 using namespace QtRestClient;
 
 IPaging::~IPaging() {}
@@ -24,3 +28,98 @@ QUrl IPaging::previous() const
 }
 
 PagingFactory::~PagingFactory() {}
+
+IPaging *PagingFactory::createPagingFromReply(QJsonSerializer *serializer, const QJsonValue &data, const QNetworkReply *reply) const
+{
+	Q_UNUSED(reply)
+	if(!data.isObject())
+		throw QJsonDeserializationException("Expected JSON object as paging object");
+	return createPaging(serializer, data.toObject());
+}
+
+QUrl PagingFactory::pageUrl(const IPaging *paging, int offset) const
+{
+	auto current = paging->offset();
+	auto pageSize = paging->items().size();
+	if(current < 0 || pageSize <= 0 || !paging->hasNext())
+		return QUrl();
+
+	//find the value of the next url that identifies the next page, as offset, 0- or 1-based index
+	const auto nextOffset = current + pageSize;
+	const auto nextIndex = current / pageSize + 1;
+	const auto offsetKeys = pageOffsetKeys();
+	const auto indexKeys = pageIndexKeys();
+
+	//only query items with a known key are replaced, and only if exactly one of them matches
+	auto url = paging->next();
+	QUrlQuery query(url);
+	auto items = query.queryItems(QUrl::FullyDecoded);
+	auto hasKey = false;
+	auto match = -1;
+	QString matchValue;
+	for(auto i = 0; i < items.size(); i++) {
+		const auto &item = items[i];
+		QString value;
+		if(offsetKeys.contains(item.first, Qt::CaseInsensitive)) {
+			hasKey = true;
+			if(item.second == QString::number(nextOffset))
+				value = QString::number(offset);
+		} else if(indexKeys.contains(item.first, Qt::CaseInsensitive)) {
+			hasKey = true;
+			if(item.second == QString::number(nextIndex))
+				value = QString::number(offset / pageSize);
+			else if(item.second == QString::number(nextIndex + 1))
+				value = QString::number(offset / pageSize + 1);
+		}
+		if(value.isNull())
+			continue;
+		if(match != -1)
+			return QUrl();
+		match = i;
+		matchValue = value;
+	}
+	if(match != -1) {
+		items[match].second = matchValue;
+		query.setQueryItems(items);
+		url.setQuery(query);
+		return url;
+	} else if(hasKey)
+		return QUrl();
+
+	//otherwise the last path segment may identify the page
+	const QList<QPair<int, int>> candidates {
+		{nextOffset, offset},
+		{nextIndex, offset / pageSize},
+		{nextIndex + 1, offset / pageSize + 1}
+	};
+	auto segments = url.path(QUrl::FullyDecoded).split(QLatin1Char('/'));
+	for(const auto &candidate : candidates) {
+		if(!segments.isEmpty() && segments.last() == QString::number(candidate.first)) {
+			segments.last() = QString::number(candidate.second);
+			url.setPath(segments.join(QLatin1Char('/')), QUrl::DecodedMode);
+			return url;
+		}
+	}
+
+	return QUrl();
+}
+
+QStringList PagingFactory::pageOffsetKeys() const
+{
+	return {
+		QStringLiteral("offset"),
+		QStringLiteral("skip"),
+		QStringLiteral("start"),
+		QStringLiteral("from")
+	};
+}
+
+QStringList PagingFactory::pageIndexKeys() const
+{
+	return {
+		QStringLiteral("page"),
+		QStringLiteral("pageNumber"),
+		QStringLiteral("page_number"),
+		QStringLiteral("pageIndex")
+	};
+}
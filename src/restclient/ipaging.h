@@ -5,8 +5,11 @@
 
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsonobject.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qstringlist.h>
 #include <QtCore/qurl.h>
 class QJsonSerializer;
+class QNetworkReply;
 
 namespace QtRestClient {
 
@@ -45,6 +48,16 @@ public:
 
 	//! Creates a new paging object of the given data
 	virtual IPaging *createPaging(QJsonSerializer *serializer, const QJsonObject &data) const = 0;
+	//! Creates a new paging object of the data, with access to the reply it was received with
+	virtual IPaging *createPagingFromReply(QJsonSerializer *serializer, const QJsonValue &data, const QNetworkReply *reply) const;
+	//! Returns the URL of the page that begins at the given offset, or an invalid URL if unknown
+	virtual QUrl pageUrl(const IPaging *paging, int offset) const;
+
+protected:
+	//! Returns the names of the query parameters that can contain the offset of a page
+	virtual QStringList pageOffsetKeys() const;
+	//! Returns the names of the query parameters that can contain the 0- or 1-based number of a page
+	virtual QStringList pageIndexKeys() const;
 };
 
 }
@@ -0,0 +1,186 @@
+#include "linkheaderpaging.h"
+
+#include <QtNetwork/QNetworkReply>
+#include <QtJsonSerializer/QJsonSerializerException>
+using namespace QtRestClient;
+
+namespace QtRestClient {
+
+class LinkHeaderPagingFactoryPrivate
+{
+public:
+	LinkHeaderPagingFactoryPrivate(const QString &itemsKey, const QByteArray &totalHeader);
+
+	QString itemsKey;
+	QByteArray totalHeader;
+};
+
+class LinkHeaderPaging : public IPaging
+{
+public:
+	LinkHeaderPaging(const QJsonValue &data, const QString &itemsKey, const QHash<QString, QUrl> &links, int total);
+
+	QJsonArray items() const override;
+	int total() const override;
+	bool hasNext() const override;
+	QUrl next() const override;
+	bool hasPrevious() const override;
+	QUrl previous() const override;
+	QVariantMap properties() const override;
+	QJsonObject originalJson() const override;
+
+private:
+	QJsonValue _data;
+	QString _itemsKey;
+	QHash<QString, QUrl> _links;
+	int _total;
+
+	mutable bool _hasProperties;
+	mutable QVariantMap _properties;
+};
+
+}
+
+LinkHeaderPagingFactory::LinkHeaderPagingFactory(const QString &itemsKey, const QByteArray &totalHeader) :
+	PagingFactory(),
+	d(new LinkHeaderPagingFactoryPrivate(itemsKey, totalHeader))
+{}
+
+LinkHeaderPagingFactory::~LinkHeaderPagingFactory() {}
+
+IPaging *LinkHeaderPagingFactory::createPaging(QJsonSerializer *serializer, const QJsonObject &data) const
+{
+	return createPagingFromReply(serializer, QJsonValue(data), nullptr);
+}
+
+IPaging *LinkHeaderPagingFactory::createPagingFromReply(QJsonSerializer *serializer, const QJsonValue &data, const QNetworkReply *reply) const
+{
+	Q_UNUSED(serializer)
+
+	//the body is either the list itself, or an object that contains it
+	if(!data.isArray() &&
+	   !(data.isObject() && data.toObject().value(d->itemsKey).isArray()))
+		throw QJsonDeserializationException("Given JSON is neither a list nor an object with items!");
+
+	QHash<QString, QUrl> links;
+	auto total = INT_MAX;
+	if(reply) {
+		links = parseLinks(reply->rawHeader("Link"), reply->url());
+		if(!d->totalHeader.isEmpty() && reply->hasRawHeader(d->totalHeader)) {
+			auto ok = false;
+			auto headerTotal = reply->rawHeader(d->totalHeader).trimmed().toInt(&ok);
+			if(ok)
+				total = headerTotal;
+		}
+	}
+	return new LinkHeaderPaging(data, d->itemsKey, links, total);
+}
+
+QHash<QString, QUrl> LinkHeaderPagingFactory::parseLinks(const QByteArray &header, const QUrl &baseUrl)
+{
+	QHash<QString, QUrl> links;
+	const auto value = QString::fromUtf8(header);
+	auto pos = 0;
+	while(pos < value.size()) {
+		auto start = value.indexOf(QLatin1Char('<'), pos);
+		if(start < 0)
+			break;
+		auto end = value.indexOf(QLatin1Char('>'), start);
+		if(end < 0)
+			break;
+		auto url = baseUrl.resolved(QUrl(value.mid(start + 1, end - start - 1).trimmed()));
+
+		//the parameters of the link end at the next comma that is not quoted
+		pos = end + 1;
+		auto inQuotes = false;
+		while(pos < value.size() && (inQuotes || value[pos] != QLatin1Char(','))) {
+			if(value[pos] == QLatin1Char('"'))
+				inQuotes = !inQuotes;
+			pos++;
+		}
+
+		const auto params = value.mid(end + 1, pos - end - 1).split(QLatin1Char(';'), QString::SkipEmptyParts);
+		for(const auto &param : params) {
+			auto sep = param.indexOf(QLatin1Char('='));
+			if(sep < 0 || param.left(sep).trimmed().toLower() != QStringLiteral("rel"))
+				continue;
+			auto rels = param.mid(sep + 1).trimmed();
+			if(rels.startsWith(QLatin1Char('"')) && rels.endsWith(QLatin1Char('"')))
+				rels = rels.mid(1, rels.size() - 2);
+			for(const auto &rel : rels.split(QLatin1Char(' '), QString::SkipEmptyParts)) {
+				if(!links.contains(rel.toLower()))
+					links.insert(rel.toLower(), url);
+			}
+		}
+	}
+	return links;
+}
+
+LinkHeaderPaging::LinkHeaderPaging(const QJsonValue &data, const QString &itemsKey, const QHash<QString, QUrl> &links, int total) :
+	IPaging(),
+	_data(data),
+	_itemsKey(itemsKey),
+	_links(links),
+	_total(total),
+	_hasProperties(false),
+	_properties()
+{}
+
+QJsonArray LinkHeaderPaging::items() const
+{
+	if(_data.isArray())
+		return _data.toArray();
+	else
+		return _data.toObject().value(_itemsKey).toArray();
+}
+
+int LinkHeaderPaging::total() const
+{
+	return _total;
+}
+
+bool LinkHeaderPaging::hasNext() const
+{
+	return _links.contains(QStringLiteral("next"));
+}
+
+QUrl LinkHeaderPaging::next() const
+{
+	return _links.value(QStringLiteral("next"));
+}
+
+bool LinkHeaderPaging::hasPrevious() const
+{
+	return _links.contains(QStringLiteral("prev")) ||
+			_links.contains(QStringLiteral("previous"));
+}
+
+QUrl LinkHeaderPaging::previous() const
+{
+	return _links.value(QStringLiteral("prev"),
+						_links.value(QStringLiteral("previous")));
+}
+
+QVariantMap LinkHeaderPaging::properties() const
+{
+	if(!_hasProperties) {
+		_properties = originalJson().toVariantMap();
+		_hasProperties = true;
+	}
+	return _properties;
+}
+
+QJsonObject LinkHeaderPaging::originalJson() const
+{
+	if(_data.isArray())
+		return QJsonObject {{_itemsKey, _data}};
+	else
+		return _data.toObject();
+}
+
+// ------------- Private Implementation -------------
+
+LinkHeaderPagingFactoryPrivate::LinkHeaderPagingFactoryPrivate(const QString &itemsKey, const QByteArray &totalHeader) :
+	itemsKey(itemsKey),
+	totalHeader(totalHeader)
+{}
@@ -0,0 +1,34 @@
+#ifndef QTRESTCLIENT_LINKHEADERPAGING_H
+#define QTRESTCLIENT_LINKHEADERPAGING_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/ipaging.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qscopedpointer.h>
+
+namespace QtRestClient {
+
+class LinkHeaderPagingFactoryPrivate;
+//! A paging factory for APIs that link pages via RFC 5988 Link headers
+class Q_RESTCLIENT_EXPORT LinkHeaderPagingFactory : public PagingFactory
+{
+public:
+	//! Creates a factory that reads the items from the body, or its itemsKey for objects
+	LinkHeaderPagingFactory(const QString &itemsKey = QStringLiteral("items"),
+							const QByteArray &totalHeader = QByteArrayLiteral("X-Total-Count"));
+	~LinkHeaderPagingFactory() override;
+
+	IPaging *createPaging(QJsonSerializer *serializer, const QJsonObject &data) const override;
+	IPaging *createPagingFromReply(QJsonSerializer *serializer, const QJsonValue &data, const QNetworkReply *reply) const override;
+
+	//! Parses the value of a Link header into its relations, with URLs resolved against baseUrl
+	static QHash<QString, QUrl> parseLinks(const QByteArray &header, const QUrl &baseUrl = {});
+
+private:
+	QScopedPointer<LinkHeaderPagingFactoryPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_LINKHEADERPAGING_H
@@ -3,7 +3,10 @@
 
 #include "QtRestClient/qtrestclient_global.h"
 
+#include <QtCore/qmetaobject.h>
 #include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qsharedpointer.h>
 
 namespace QtRestClient {
 
@@ -30,6 +33,27 @@ public:
 		for(T *obj : list)
 			obj->deleteLater();
 	}
+	static inline QList<QPointer<QObject>> guardAll(const QList<T*> &list) {
+		QList<QPointer<QObject>> guards;
+		guards.reserve(list.size());
+		for(T *obj : list)
+			guards.append(obj);
+		return guards;
+	}
+	static inline QSharedPointer<QObject> adoptAll(const QList<T*> &list) {
+		QSharedPointer<QObject> owner(new QObject(), &QObject::deleteLater);
+		for(T *obj : list) {
+			if(obj)
+				obj->setParent(owner.data());
+		}
+		return owner;
+	}
+	static inline const QMetaObject *metaObject() {
+		return &T::staticMetaObject;
+	}
+	static inline QVariant readProperty(const QMetaProperty &property, T *obj) {
+		return obj ? property.read(obj) : QVariant();
+	}
 };
 
 //! @private
@@ -40,6 +64,18 @@ public:
 	typedef std::true_type is_meta;
 	static inline void deleteLater(T) {}
 	static inline void deleteAllLater(const QList<T> &) {}
+	static inline QList<QPointer<QObject>> guardAll(const QList<T> &) {
+		return {};
+	}
+	static inline QSharedPointer<QObject> adoptAll(const QList<T> &) {
+		return {};
+	}
+	static inline const QMetaObject *metaObject() {
+		return &T::staticMetaObject;
+	}
+	static inline QVariant readProperty(const QMetaProperty &property, const T &obj) {
+		return property.readOnGadget(&obj);
+	}
 };
 
 }
@@ -0,0 +1,243 @@
+#include "metricssnapshot.h"
+#include "metricssnapshot_p.h"
+using namespace QtRestClient;
+
+namespace {
+
+QByteArray escapeLabel(const QByteArray &value)
+{
+	QByteArray escaped;
+	escaped.reserve(value.size());
+	for(auto c : value) {
+		switch (c) {
+		case '\\':
+			escaped += "\\\\";
+			break;
+		case '"':
+			escaped += "\\\"";
+			break;
+		case '\n':
+			escaped += "\\n";
+			break;
+		default:
+			escaped += c;
+			break;
+		}
+	}
+	return escaped;
+}
+
+void writeHeader(QByteArray &out, const QByteArray &name, const QByteArray &type, const QByteArray &help)
+{
+	out += "# HELP " + name + ' ' + help + '\n';
+	out += "# TYPE " + name + ' ' + type + '\n';
+}
+
+void writeScalar(QByteArray &out, const QByteArray &name, const QByteArray &type, const QByteArray &help, quint64 value)
+{
+	writeHeader(out, name, type, help);
+	out += name + ' ' + QByteArray::number(value) + '\n';
+}
+
+void writeHistogram(QByteArray &out, const QByteArray &name, const QByteArray &help, const MetricsSnapshot::Histogram &histogram)
+{
+	writeHeader(out, name, "histogram", help);
+	quint64 cumulative = 0;
+	for(auto i = 0; i < histogram.upperBounds.size(); i++) {
+		cumulative += histogram.bucketCounts.value(i);
+		out += name + "_bucket{le=\"" + QByteArray::number(histogram.upperBounds[i]) + "\"} " +
+			   QByteArray::number(cumulative) + '\n';
+	}
+	out += name + "_bucket{le=\"+Inf\"} " + QByteArray::number(histogram.count) + '\n';
+	out += name + "_sum " + QByteArray::number(histogram.sum, 'g', 10) + '\n';
+	out += name + "_count " + QByteArray::number(histogram.count) + '\n';
+}
+
+}
+
+MetricsSnapshot::MetricsSnapshot() :
+	d(new MetricsSnapshotPrivate())
+{}
+
+MetricsSnapshot::MetricsSnapshot(const MetricsSnapshot &other) :
+	d(other.d)
+{}
+
+MetricsSnapshot::~MetricsSnapshot() {}
+
+QList<MetricsSnapshot::RequestCount> MetricsSnapshot::requests() const
+{
+	QList<RequestCount> counts;
+	for(auto it = d->requests.constBegin(); it != d->requests.constEnd(); it++) {
+		counts.append({
+						  std::get<0>(it.key()),
+						  std::get<1>(it.key()),
+						  std::get<2>(it.key()),
+						  it.value()
+					  });
+	}
+	return counts;
+}
+
+quint64 MetricsSnapshot::requestCount() const
+{
+	return d->requestDuration.count;
+}
+
+int MetricsSnapshot::inFlight() const
+{
+	return d->inFlight;
+}
+
+quint64 MetricsSnapshot::bytesSent() const
+{
+	return d->bytesSent;
+}
+
+quint64 MetricsSnapshot::bytesReceived() const
+{
+	return d->bytesReceived;
+}
+
+quint64 MetricsSnapshot::retries() const
+{
+	return d->retries;
+}
+
+quint64 MetricsSnapshot::cacheHits() const
+{
+	return d->cacheHits;
+}
+
+MetricsSnapshot::Histogram MetricsSnapshot::requestDuration() const
+{
+	return d->requestDuration;
+}
+
+MetricsSnapshot::Histogram MetricsSnapshot::parseDuration() const
+{
+	return d->parseDuration;
+}
+
+MetricsSnapshot::Histogram MetricsSnapshot::deserializeDuration() const
+{
+	return d->deserializeDuration;
+}
+
+QByteArray MetricsSnapshot::toPrometheus(const QByteArray &prefix) const
+{
+	QByteArray out;
+
+	auto name = prefix + "_requests_total";
+	writeHeader(out, name, "counter", "Completed requests by verb, status class and route.");
+	for(auto it = d->requests.constBegin(); it != d->requests.constEnd(); it++) {
+		out += name +
+			   "{verb=\"" + escapeLabel(std::get<0>(it.key())) +
+			   "\",status_class=\"" + escapeLabel(std::get<1>(it.key())) +
+			   "\",route=\"" + escapeLabel(std::get<2>(it.key()).toUtf8()) +
+			   "\"} " + QByteArray::number(it.value()) + '\n';
+	}
+
+	writeScalar(out, prefix + "_requests_in_flight", "gauge",
+				"Requests that have been sent, but not completed yet.",
+				static_cast<quint64>(qMax(d->inFlight, 0)));
+	writeScalar(out, prefix + "_sent_bytes_total", "counter",
+				"Request body bytes sent.",
+				d->bytesSent);
+	writeScalar(out, prefix + "_received_bytes_total", "counter",
+				"Reply body bytes received.",
+				d->bytesReceived);
+	writeScalar(out, prefix + "_retries_total", "counter",
+				"Requests that were retries of an earlier request.",
+				d->retries);
+	writeScalar(out, prefix + "_cache_hits_total", "counter",
+				"Requests that were answered from a cache.",
+				d->cacheHits);
+
+	writeHistogram(out, prefix + "_request_duration_seconds",
+				   "Time from creating a request until all handlers were called.",
+				   d->requestDuration);
+	writeHistogram(out, prefix + "_parse_duration_seconds",
+				   "Time spent on parsing replies to JSON.",
+				   d->parseDuration);
+	writeHistogram(out, prefix + "_deserialize_duration_seconds",
+				   "Time spent on deserializing JSON to the target types.",
+				   d->deserializeDuration);
+
+	return out;
+}
+
+MetricsSnapshot &MetricsSnapshot::operator=(const MetricsSnapshot &other)
+{
+	d = other.d;
+	return *this;
+}
+
+MetricsSnapshot::Histogram::Histogram(const QVector<double> &upperBounds) :
+	upperBounds(upperBounds),
+	bucketCounts(upperBounds.size() + 1, 0),
+	sum(0.0),
+	count(0)
+{}
+
+void MetricsSnapshot::Histogram::observe(double value)
+{
+	auto bucket = 0;
+	while(bucket < upperBounds.size() && value > upperBounds[bucket])
+		bucket++;
+	bucketCounts[bucket]++;
+	sum += value;
+	count++;
+}
+
+// ------------- Private Implementation -------------
+
+const QVector<double> MetricsSnapshotPrivate::DurationBuckets {
+	0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+const QVector<double> MetricsSnapshotPrivate::ProcessingBuckets {
+	0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25
+};
+
+MetricsSnapshotPrivate::MetricsSnapshotPrivate() :
+	QSharedData(),
+	requests(),
+	inFlight(0),
+	bytesSent(0),
+	bytesReceived(0),
+	retries(0),
+	cacheHits(0),
+	requestDuration(DurationBuckets),
+	parseDuration(ProcessingBuckets),
+	deserializeDuration(ProcessingBuckets)
+{}
+
+QByteArray MetricsSnapshotPrivate::statusClass(int status)
+{
+	if(status < 100 || status > 599)
+		return "error";
+	else
+		return QByteArray::number(status / 100) + "xx";
+}
+
+void MetricsSnapshotPrivate::record(const RequestMetrics &metrics)
+{
+	requests[RequestKey(metrics.verb(), statusClass(metrics.status()), metrics.route())]++;
+	bytesSent += static_cast<quint64>(qMax<qint64>(metrics.bytesSent(), 0));
+	bytesReceived += static_cast<quint64>(qMax<qint64>(metrics.bytesReceived(), 0));
+	if(metrics.retryCount() > 0)
+		retries++;
+	if(metrics.fromCache())
+		cacheHits++;
+
+	auto toSeconds = [](qint64 nsecs) {
+		return static_cast<double>(nsecs) / 1000000000.0;
+	};
+	requestDuration.observe(toSeconds(qMax<qint64>(metrics.timestamp(RequestMetrics::HandlerDone), 0)));
+	auto parse = metrics.duration(RequestMetrics::Finished, RequestMetrics::Parsed);
+	if(parse >= 0)
+		parseDuration.observe(toSeconds(parse));
+	auto deserialize = metrics.duration(RequestMetrics::Parsed, RequestMetrics::Deserialized);
+	if(deserialize >= 0)
+		deserializeDuration.observe(toSeconds(deserialize));
+}
@@ -0,0 +1,82 @@
+#ifndef QTRESTCLIENT_METRICSSNAPSHOT_H
+#define QTRESTCLIENT_METRICSSNAPSHOT_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+namespace QtRestClient {
+
+class RequestMetrics;
+
+struct MetricsSnapshotPrivate;
+//! The aggregated request metrics of a RestClient at a certain point in time
+class Q_RESTCLIENT_EXPORT MetricsSnapshot
+{
+	friend class RestClientPrivate;
+
+public:
+	//! The number of completed requests for one combination of labels
+	struct RequestCount {
+		QByteArray verb;//!< The HTTP verb of the requests
+		QByteArray statusClass;//!< The status class, i.e. `2xx`, or `error` if no status was received
+		QString route;//!< The path of the RestClass the requests were sent by
+		quint64 count;//!< The number of requests
+	};
+
+	//! A histogram of durations, in seconds
+	struct Histogram {
+		QVector<double> upperBounds;//!< The upper bounds of the buckets, without `+Inf`
+		QVector<quint64> bucketCounts;//!< The number of observations per bucket, not cumulative. The last one is `+Inf`
+		double sum;//!< The sum of all observations
+		quint64 count;//!< The number of observations
+
+		//! Creates a histogram with the given bucket bounds
+		Histogram(const QVector<double> &upperBounds = {});
+		//! Adds a single observation to the histogram
+		void observe(double value);
+	};
+
+	//! Constructor
+	MetricsSnapshot();
+	//! Copy Constructor
+	MetricsSnapshot(const MetricsSnapshot &other);
+	~MetricsSnapshot();
+
+	//! Returns the completed requests, split by their labels
+	QList<RequestCount> requests() const;
+	//! Returns the total number of completed requests
+	quint64 requestCount() const;
+	//! Returns the number of requests that have been sent, but not completed yet
+	int inFlight() const;
+	//! Returns the number of body bytes sent by all completed requests
+	quint64 bytesSent() const;
+	//! Returns the number of body bytes received by all completed requests
+	quint64 bytesReceived() const;
+	//! Returns the number of requests that were retries of earlier requests
+	quint64 retries() const;
+	//! Returns the number of requests that were answered from a cache
+	quint64 cacheHits() const;
+
+	//! Returns the histogram of the total request durations
+	Histogram requestDuration() const;
+	//! Returns the histogram of the time spent on parsing replies to JSON
+	Histogram parseDuration() const;
+	//! Returns the histogram of the time spent on deserializing JSON
+	Histogram deserializeDuration() const;
+
+	//! Renders the snapshot in the Prometheus text exposition format
+	QByteArray toPrometheus(const QByteArray &prefix = "qtrestclient") const;
+
+	//! Assignment operator
+	MetricsSnapshot &operator=(const MetricsSnapshot &other);
+
+private:
+	QSharedDataPointer<MetricsSnapshotPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_METRICSSNAPSHOT_H
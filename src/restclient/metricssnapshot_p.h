@@ -0,0 +1,37 @@
+#ifndef QTRESTCLIENT_METRICSSNAPSHOT_P_H
+#define QTRESTCLIENT_METRICSSNAPSHOT_P_H
+
+#include "metricssnapshot.h"
+#include "requestmetrics.h"
+
+#include <QtCore/QMap>
+#include <tuple>
+
+namespace QtRestClient {
+
+struct Q_RESTCLIENT_EXPORT MetricsSnapshotPrivate : public QSharedData
+{
+	typedef std::tuple<QByteArray, QByteArray, QString> RequestKey;
+
+	static const QVector<double> DurationBuckets;
+	static const QVector<double> ProcessingBuckets;
+
+	QMap<RequestKey, quint64> requests;
+	int inFlight;
+	quint64 bytesSent;
+	quint64 bytesReceived;
+	quint64 retries;
+	quint64 cacheHits;
+	MetricsSnapshot::Histogram requestDuration;
+	MetricsSnapshot::Histogram parseDuration;
+	MetricsSnapshot::Histogram deserializeDuration;
+
+	MetricsSnapshotPrivate();
+
+	static QByteArray statusClass(int status);
+	void record(const RequestMetrics &metrics);
+};
+
+}
+
+#endif // QTRESTCLIENT_METRICSSNAPSHOT_P_H
@@ -0,0 +1,411 @@
+#include "offlinequeue.h"
+#include "offlinequeue_p.h"
+#include "restreply_p.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+using namespace QtRestClient;
+
+OfflineQueue::OfflineQueue(RestClient *client, const QString &storagePath) :
+	QObject(client),
+	d(new OfflineQueuePrivate(client, storagePath, this))
+{
+	connect(d->retryTimer, &QTimer::timeout,
+			this, [this](){
+		//probe with the first request only, until the server is reachable again
+		if(!d->online && d->activeCount == 0 && !d->entries.isEmpty())
+			d->send(d->entries.first());
+	});
+	d->load();
+	if(!d->entries.isEmpty())
+		QTimer::singleShot(0, this, [this](){
+			d->dispatch();
+		});
+}
+
+OfflineQueue::~OfflineQueue() {}
+
+RestClient *OfflineQueue::client() const
+{
+	return d->client;
+}
+
+QString OfflineQueue::storagePath() const
+{
+	return d->storagePath;
+}
+
+bool OfflineQueue::isOnline() const
+{
+	return d->online;
+}
+
+int OfflineQueue::maxConcurrentRequests() const
+{
+	return d->maxConcurrentRequests;
+}
+
+int OfflineQueue::retryInterval() const
+{
+	return d->retryInterval;
+}
+
+int OfflineQueue::pendingCount() const
+{
+	return d->entries.size();
+}
+
+QList<QUuid> OfflineQueue::pendingRequests() const
+{
+	QList<QUuid> ids;
+	ids.reserve(d->entries.size());
+	for(auto entry : d->entries)
+		ids.append(entry.id);
+	return ids;
+}
+
+bool OfflineQueue::isPending(const QUuid &id) const
+{
+	return d->indexOf(id) != -1;
+}
+
+QUuid OfflineQueue::enqueue(const RequestBuilder &builder)
+{
+	if(builder.hasMultiPartBody()) {
+		qWarning() << "Multipart requests can't be added to an OfflineQueue";
+		return QUuid();
+	}
+
+	OfflineQueuePrivate::Entry entry;
+	entry.id = QUuid::createUuid();
+	entry.verb = builder.verb();
+	entry.url = builder.buildUrl();
+	entry.created = QDateTime::currentDateTimeUtc();
+	entry.active = false;
+
+	auto device = builder.bodyDevice();
+	if(device) {
+		auto pos = device->pos();
+		entry.body = device->readAll();
+		if(!device->isSequential())
+			device->seek(pos);
+	} else
+		entry.body = builder.body();
+
+	//credentials and trace context are added again when the request is sent
+	auto headers = builder.headers();
+	for(auto it = headers.constBegin(); it != headers.constEnd(); it++) {
+		if(!OfflineQueuePrivate::VolatileHeaders.contains(it.key().toLower()))
+			entry.headers.insert(it.key(), it.value());
+	}
+
+	if(!d->appendRecord(OfflineQueuePrivate::AddRecord, entry))
+		qWarning() << "Failed to journal request to" << d->storagePath;
+	d->entries.append(entry);
+	emit pendingCountChanged(d->entries.size(), {});
+	d->dispatch();
+	return entry.id;
+}
+
+OfflineQueue *OfflineQueue::onCompleted(const QUuid &id, std::function<void(int, QJsonValue)> handler)
+{
+	d->handlers[id].completed = handler;
+	return this;
+}
+
+OfflineQueue *OfflineQueue::onError(const QUuid &id, std::function<void(QString, int, RestReply::ErrorType)> handler)
+{
+	d->handlers[id].error = handler;
+	return this;
+}
+
+bool OfflineQueue::remove(const QUuid &id)
+{
+	auto index = d->indexOf(id);
+	if(index == -1 || d->entries[index].active)
+		return false;
+	d->handlers.remove(id);
+	d->finish(id);
+	return true;
+}
+
+void OfflineQueue::flush()
+{
+	d->retryTimer->stop();
+	if(d->online)
+		d->dispatch();
+	else
+		setOnline(true);
+}
+
+void OfflineQueue::setOnline(bool online)
+{
+	if (d->online == online)
+		return;
+
+	d->online = online;
+	if(online)
+		d->retryTimer->stop();
+	emit onlineChanged(online, {});
+	d->dispatch();
+}
+
+void OfflineQueue::setMaxConcurrentRequests(int maxConcurrentRequests)
+{
+	maxConcurrentRequests = qMax(maxConcurrentRequests, 1);
+	if (d->maxConcurrentRequests == maxConcurrentRequests)
+		return;
+
+	d->maxConcurrentRequests = maxConcurrentRequests;
+	emit maxConcurrentRequestsChanged(maxConcurrentRequests, {});
+	d->dispatch();
+}
+
+void OfflineQueue::setRetryInterval(int retryInterval)
+{
+	if (d->retryInterval == retryInterval)
+		return;
+
+	d->retryInterval = retryInterval;
+	d->retryTimer->setInterval(retryInterval);
+	emit retryIntervalChanged(retryInterval, {});
+}
+
+// ------------- Private Implementation -------------
+
+const quint32 OfflineQueuePrivate::StorageVersion = 1;
+//records are appended by different runs, so the stream format must not change with Qt
+const QDataStream::Version OfflineQueuePrivate::StreamVersion = QDataStream::Qt_5_6;
+const QByteArrayList OfflineQueuePrivate::VolatileHeaders {
+	"authorization",
+	"traceparent",
+	"tracestate"
+};
+const int OfflineQueuePrivate::CompactThreshold = 64;
+
+OfflineQueuePrivate::OfflineQueuePrivate(RestClient *client, const QString &storagePath, OfflineQueue *q_ptr) :
+	client(client),
+	storagePath(storagePath),
+	online(true),
+	maxConcurrentRequests(2),
+	retryInterval(30000),
+	entries(),
+	handlers(),
+	activeCount(0),
+	removedRecords(0),
+	retryTimer(new QTimer(q_ptr)),
+	q(q_ptr)
+{
+	retryTimer->setSingleShot(true);
+	retryTimer->setInterval(retryInterval);
+}
+
+void OfflineQueuePrivate::dispatch()
+{
+	if(!client || !online)
+		return;
+	//requests are started strictly in the order they were queued
+	for(auto i = 0; i < entries.size() && activeCount < maxConcurrentRequests; i++) {
+		if(!entries[i].active)
+			send(entries[i]);
+	}
+}
+
+void OfflineQueuePrivate::send(Entry &entry)
+{
+	entry.active = true;
+	activeCount++;
+
+	auto builder = client->builder()
+				   .updateFromRelativeUrl(entry.url)
+				   .addHeaders(entry.headers)
+				   .setVerb(entry.verb);
+	if(!entry.body.isEmpty()) {
+		QByteArray contentType("application/octet-stream");
+		for(auto it = entry.headers.constBegin(); it != entry.headers.constEnd(); it++) {
+			if(it.key().toLower() == "content-type")
+				contentType = it.value();
+		}
+		builder.setBody(entry.body, contentType);
+	}
+
+	auto id = entry.id;
+	auto reply = new RestReply(builder.send(), q);
+	QObject::connect(reply, &RestReply::completed, q, [this, id](int httpStatus, const QJsonValue &value){
+		finish(id);
+		auto entryHandlers = handlers.take(id);
+		emit q->requestCompleted(id, httpStatus, value, {});
+		if(entryHandlers.completed)
+			entryHandlers.completed(httpStatus, value);
+		//any reply proves the server is reachable
+		if(!online)
+			q->setOnline(true);
+		else
+			dispatch();
+	});
+	QObject::connect(reply, &RestReply::error, q, [this, id, reply](const QString &errorString, int error, RestReply::ErrorType errorType){
+		auto replyPrivate = RestReplyPrivate::of(reply->networkReply());
+		auto timedOut = replyPrivate && replyPrivate->isTimeout();
+		if(errorType == RestReply::NetworkError && (isConnectivityError(error) || timedOut)) {
+			networkFailed(id);
+			return;
+		}
+		finish(id);
+		auto entryHandlers = handlers.take(id);
+		emit q->requestError(id, errorString, error, errorType, {});
+		if(entryHandlers.error)
+			entryHandlers.error(errorString, error, errorType);
+		if(!online)
+			q->setOnline(true);
+		else
+			dispatch();
+	});
+}
+
+void OfflineQueuePrivate::finish(const QUuid &id)
+{
+	auto index = indexOf(id);
+	if(index == -1)
+		return;
+	if(entries[index].active)
+		activeCount--;
+	appendRecord(RemoveRecord, entries[index]);
+	entries.removeAt(index);
+	//the journal is rewritten once it is mostly made of removed requests
+	if(++removedRecords > CompactThreshold && removedRecords > entries.size())
+		compact();
+	emit q->pendingCountChanged(entries.size(), {});
+}
+
+void OfflineQueuePrivate::networkFailed(const QUuid &id)
+{
+	auto index = indexOf(id);
+	if(index != -1 && entries[index].active) {
+		entries[index].active = false;
+		activeCount--;
+	}
+	q->setOnline(false);
+	if(retryInterval >= 0 && activeCount == 0)
+		retryTimer->start();
+}
+
+int OfflineQueuePrivate::indexOf(const QUuid &id) const
+{
+	for(auto i = 0; i < entries.size(); i++) {
+		if(entries[i].id == id)
+			return i;
+	}
+	return -1;
+}
+
+bool OfflineQueuePrivate::load()
+{
+	QFile file(storagePath);
+	if(!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream stream(&file);
+	stream.setVersion(StreamVersion);
+	quint32 version = 0;
+	stream >> version;
+	if(version != StorageVersion)
+		return false;
+
+	//replays the journal, a record cut off by a crash ends it
+	while(!stream.atEnd()) {
+		quint8 type = 0;
+		Entry entry;
+		stream >> type >> entry.id;
+		if(type == AddRecord)
+			stream >> entry;
+		if(stream.status() != QDataStream::Ok)
+			break;
+
+		if(type == AddRecord) {
+			entry.active = false;
+			if(indexOf(entry.id) == -1)
+				entries.append(entry);
+		} else if(type == RemoveRecord) {
+			auto index = indexOf(entry.id);
+			if(index != -1)
+				entries.removeAt(index);
+		}
+	}
+	file.close();
+	return compact();
+}
+
+bool OfflineQueuePrivate::compact()
+{
+	removedRecords = 0;
+	QFileInfo info(storagePath);
+	if(!info.dir().mkpath(QStringLiteral(".")))
+		return false;
+
+	QSaveFile file(storagePath);
+	if(!file.open(QIODevice::WriteOnly))
+		return false;
+	//the requests can contain personal data
+	file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+
+	QDataStream stream(&file);
+	stream.setVersion(StreamVersion);
+	stream << StorageVersion;
+	for(auto entry : entries)
+		stream << static_cast<quint8>(AddRecord) << entry.id << entry;
+	return file.commit();
+}
+
+bool OfflineQueuePrivate::appendRecord(RecordType type, const Entry &entry)
+{
+	QFileInfo info(storagePath);
+	if(!info.exists() || info.size() == 0)
+		return compact() && appendRecord(type, entry);
+
+	QFile file(storagePath);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Append))
+		return false;
+	QDataStream stream(&file);
+	stream.setVersion(StreamVersion);
+	stream << static_cast<quint8>(type) << entry.id;
+	if(type == AddRecord)
+		stream << entry;
+	return stream.status() == QDataStream::Ok && file.flush();
+}
+
+bool OfflineQueuePrivate::isConnectivityError(int error)
+{
+	switch (error) {
+	case QNetworkReply::TooManyRedirectsError:
+	case QNetworkReply::InsecureRedirectError:
+	case QNetworkReply::SslHandshakeFailedError:
+	case QNetworkReply::OperationCanceledError:
+		return false;
+	default:
+		//connection and proxy errors
+		return error > QNetworkReply::NoError && error < QNetworkReply::ContentAccessDenied;
+	}
+}
+
+QDataStream &QtRestClient::operator<<(QDataStream &stream, const OfflineQueuePrivate::Entry &entry)
+{
+	stream << entry.verb
+		   << entry.url
+		   << entry.headers
+		   << entry.body
+		   << entry.created;
+	return stream;
+}
+
+QDataStream &QtRestClient::operator>>(QDataStream &stream, OfflineQueuePrivate::Entry &entry)
+{
+	stream >> entry.verb
+		   >> entry.url
+		   >> entry.headers
+		   >> entry.body
+		   >> entry.created;
+	return stream;
+}
@@ -0,0 +1,101 @@
+#ifndef QTRESTCLIENT_OFFLINEQUEUE_H
+#define QTRESTCLIENT_OFFLINEQUEUE_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/requestbuilder.h"
+#include "QtRestClient/restreply.h"
+
+#include <QtCore/qobject.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/quuid.h>
+#include <functional>
+
+namespace QtRestClient {
+
+class RestClient;
+
+class OfflineQueuePrivate;
+//! A durable queue of requests, that are sent as soon as the network is available
+class Q_RESTCLIENT_EXPORT OfflineQueue : public QObject
+{
+	Q_OBJECT
+	friend class OfflineQueuePrivate;
+
+	//! The file the queued requests are journaled to
+	Q_PROPERTY(QString storagePath READ storagePath CONSTANT)
+	//! Specifies, whether the server is currently believed to be reachable
+	Q_PROPERTY(bool online READ isOnline WRITE setOnline NOTIFY onlineChanged)
+	//! The maximum number of queued requests that are sent at the same time
+	Q_PROPERTY(int maxConcurrentRequests READ maxConcurrentRequests WRITE setMaxConcurrentRequests NOTIFY maxConcurrentRequestsChanged)
+	//! The time in milliseconds after which a request is sent again, once the network has failed
+	Q_PROPERTY(int retryInterval READ retryInterval WRITE setRetryInterval NOTIFY retryIntervalChanged)
+	//! The number of requests that have not been completed yet
+	Q_PROPERTY(int pendingCount READ pendingCount NOTIFY pendingCountChanged)
+
+public:
+	//! Creates a queue for the client, that journals to the given file, and loads the requests in it
+	OfflineQueue(RestClient *client, const QString &storagePath);
+	~OfflineQueue();
+
+	//! Returns the client the requests are sent with
+	RestClient *client() const;
+
+	//! @readAcFn{OfflineQueue::storagePath}
+	QString storagePath() const;
+	//! @readAcFn{OfflineQueue::online}
+	bool isOnline() const;
+	//! @readAcFn{OfflineQueue::maxConcurrentRequests}
+	int maxConcurrentRequests() const;
+	//! @readAcFn{OfflineQueue::retryInterval}
+	int retryInterval() const;
+	//! @readAcFn{OfflineQueue::pendingCount}
+	int pendingCount() const;
+
+	//! Returns the ids of all requests that have not been completed yet, in the order they are sent
+	QList<QUuid> pendingRequests() const;
+	//! Checks, whether the request with the given id has not been completed yet
+	bool isPending(const QUuid &id) const;
+
+	//! Journals the request of the builder, and sends it once all previous ones have been sent
+	QUuid enqueue(const RequestBuilder &builder);
+
+	//! Set a handler to be called once the request with the id has been completed
+	OfflineQueue *onCompleted(const QUuid &id, std::function<void(int, QJsonValue)> handler);
+	//! Set a handler to be called if the request with the id failed permanently
+	OfflineQueue *onError(const QUuid &id, std::function<void(QString, int, RestReply::ErrorType)> handler);
+
+public Q_SLOTS:
+	//! Removes the request with the given id from the queue, unless it is currently being sent
+	bool remove(const QUuid &id);
+	//! Sends the queued requests now, without waiting for the retryInterval
+	void flush();
+
+	//! @writeAcFn{OfflineQueue::online}
+	void setOnline(bool online);
+	//! @writeAcFn{OfflineQueue::maxConcurrentRequests}
+	void setMaxConcurrentRequests(int maxConcurrentRequests);
+	//! @writeAcFn{OfflineQueue::retryInterval}
+	void setRetryInterval(int retryInterval);
+
+Q_SIGNALS:
+	//! Is emitted when the server has replied to a queued request, regardless of success or failure
+	void requestCompleted(const QUuid &id, int httpStatus, const QJsonValue &reply, QPrivateSignal);
+	//! Is emitted when a queued request failed permanently and has been removed from the queue
+	void requestError(const QUuid &id, const QString &errorString, int error, QtRestClient::RestReply::ErrorType errorType, QPrivateSignal);
+
+	//! @notifyAcFn{OfflineQueue::online}
+	void onlineChanged(bool online, QPrivateSignal);
+	//! @notifyAcFn{OfflineQueue::maxConcurrentRequests}
+	void maxConcurrentRequestsChanged(int maxConcurrentRequests, QPrivateSignal);
+	//! @notifyAcFn{OfflineQueue::retryInterval}
+	void retryIntervalChanged(int retryInterval, QPrivateSignal);
+	//! @notifyAcFn{OfflineQueue::pendingCount}
+	void pendingCountChanged(int pendingCount, QPrivateSignal);
+
+private:
+	QScopedPointer<OfflineQueuePrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_OFFLINEQUEUE_H
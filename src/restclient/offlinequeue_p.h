@@ -0,0 +1,80 @@
+#ifndef QTRESTCLIENT_OFFLINEQUEUE_P_H
+#define QTRESTCLIENT_OFFLINEQUEUE_P_H
+
+#include "offlinequeue.h"
+#include "restclient.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT OfflineQueuePrivate
+{
+	friend class OfflineQueue;
+
+public:
+	static const quint32 StorageVersion;
+	static const QDataStream::Version StreamVersion;
+	static const QByteArrayList VolatileHeaders;
+	static const int CompactThreshold;
+
+	enum RecordType : quint8 {
+		AddRecord = 1,
+		RemoveRecord = 2
+	};
+
+	struct Entry {
+		QUuid id;
+		QByteArray verb;
+		QUrl url;
+		HeaderHash headers;
+		QByteArray body;
+		QDateTime created;
+		bool active;
+	};
+
+	struct Handlers {
+		std::function<void(int, QJsonValue)> completed;
+		std::function<void(QString, int, RestReply::ErrorType)> error;
+	};
+
+	QPointer<RestClient> client;
+	QString storagePath;
+	bool online;
+	int maxConcurrentRequests;
+	int retryInterval;
+
+	QList<Entry> entries;
+	QHash<QUuid, Handlers> handlers;
+	int activeCount;
+	int removedRecords;
+	QTimer *retryTimer;
+
+	OfflineQueuePrivate(RestClient *client, const QString &storagePath, OfflineQueue *q_ptr);
+
+	void dispatch();
+	void send(Entry &entry);
+	void finish(const QUuid &id);
+	void networkFailed(const QUuid &id);
+
+	int indexOf(const QUuid &id) const;
+	bool load();
+	bool compact();
+	bool appendRecord(RecordType type, const Entry &entry);
+
+	static bool isConnectivityError(int error);
+
+private:
+	OfflineQueue *q;
+};
+
+QDataStream &operator<<(QDataStream &stream, const OfflineQueuePrivate::Entry &entry);
+QDataStream &operator>>(QDataStream &stream, OfflineQueuePrivate::Entry &entry);
+
+}
+
+#endif // QTRESTCLIENT_OFFLINEQUEUE_P_H
@@ -0,0 +1,173 @@
+#include "pagecache.h"
+#include "pagecache_p.h"
+#include "restreply_p.h"
+#include "staticreply.h"
+
+#include <QtCore/QTimer>
+using namespace QtRestClient;
+
+PageCacheEntry::PageCacheEntry(int typeId, const QList<QPointer<QObject>> &guards) :
+	_typeId(typeId),
+	_guards(guards)
+{}
+
+PageCacheEntry::~PageCacheEntry() = default;
+
+int PageCacheEntry::typeId() const
+{
+	return _typeId;
+}
+
+bool PageCacheEntry::isAlive() const
+{
+	return isAlive(_guards);
+}
+
+bool PageCacheEntry::isAlive(const QList<QPointer<QObject>> &guards)
+{
+	for(const auto &guard : guards) {
+		if(!guard)
+			return false;
+	}
+	return true;
+}
+
+QNetworkReply *PageCacheEntry::createReply(const RequestBuilder &builder, const QList<QPointer<QObject>> &guards)
+{
+	auto reply = new StaticReply(builder.build(), 200, QByteArrayLiteral("{}"));
+	reply->setAttribute(QNetworkRequest::SourceIsFromCacheAttribute, true);
+	//the resend goes through the interceptors, like any other request
+	reply->setProperty(RestReplyPrivate::PropertyBuilder, QVariant::fromValue(QSharedPointer<RequestBuilder>::create(builder)));
+	//connected before the RestReply: if items were deleted since the request, send it for real instead
+	QObject::connect(reply, &QNetworkReply::finished, reply, [reply, guards](){
+		if(reply->error() != QNetworkReply::NoError || isAlive(guards))
+			return;
+		auto replyPrivate = RestReplyPrivate::of(reply);
+		if(!replyPrivate)
+			return;
+		replyPrivate->parked = true;
+		QTimer::singleShot(0, replyPrivate, [replyPrivate](){
+			replyPrivate->resume(true);
+		});
+	});
+	return reply;
+}
+
+PageCache::PageCache(QObject *parent) :
+	QObject(parent),
+	d(new PageCachePrivate())
+{}
+
+PageCache::~PageCache() {}
+
+int PageCache::maxPages() const
+{
+	return d->maxPages;
+}
+
+int PageCache::maxAge() const
+{
+	return d->maxAge;
+}
+
+int PageCache::size() const
+{
+	return d->entries.size();
+}
+
+bool PageCache::contains(const QUrl &url) const
+{
+	auto it = d->entries.constFind(url);
+	return it != d->entries.constEnd() &&
+			!d->isExpired(*it) &&
+			it->entry->isAlive();
+}
+
+void PageCache::remove(const QUrl &url)
+{
+	if(d->entries.remove(url) > 0)
+		d->recentlyUsed.removeOne(url);
+}
+
+void PageCache::clear()
+{
+	d->entries.clear();
+	d->recentlyUsed.clear();
+}
+
+void PageCache::setMaxPages(int maxPages)
+{
+	maxPages = qMax(0, maxPages);
+	if(d->maxPages == maxPages)
+		return;
+
+	d->maxPages = maxPages;
+	d->evict();
+	emit maxPagesChanged(d->maxPages, {});
+}
+
+void PageCache::setMaxAge(int maxAge)
+{
+	maxAge = qMax(0, maxAge);
+	if(d->maxAge == maxAge)
+		return;
+
+	d->maxAge = maxAge;
+	emit maxAgeChanged(d->maxAge, {});
+}
+
+QSharedPointer<PageCacheEntry> PageCache::findEntry(const QUrl &url, int typeId) const
+{
+	auto it = d->entries.constFind(url);
+	if(it == d->entries.constEnd())
+		return {};
+	//expired pages and pages with deleted items are never served again
+	if(d->isExpired(*it) || !it->entry->isAlive()) {
+		const_cast<PageCache*>(this)->remove(url);
+		return {};
+	}
+	if(it->entry->typeId() != typeId)
+		return {};
+
+	auto entry = it->entry;
+	d->touch(url);
+	return entry;
+}
+
+void PageCache::insertEntry(const QUrl &url, const QSharedPointer<PageCacheEntry> &entry)
+{
+	if(d->maxPages == 0)
+		return;
+
+	auto &cacheEntry = d->entries[url];
+	cacheEntry.entry = entry;
+	cacheEntry.age.start();
+	d->touch(url);
+	d->evict();
+}
+
+// ------------- Private Implementation -------------
+
+PageCachePrivate::PageCachePrivate() :
+	maxPages(32),
+	maxAge(300),
+	entries(),
+	recentlyUsed()
+{}
+
+bool PageCachePrivate::isExpired(const Entry &entry) const
+{
+	return maxAge > 0 && entry.age.hasExpired(maxAge * 1000ll);
+}
+
+void PageCachePrivate::touch(const QUrl &url)
+{
+	recentlyUsed.removeOne(url);
+	recentlyUsed.append(url);
+}
+
+void PageCachePrivate::evict()
+{
+	while(recentlyUsed.size() > maxPages)
+		entries.remove(recentlyUsed.takeFirst());
+}
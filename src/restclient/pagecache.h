@@ -0,0 +1,101 @@
+#ifndef QTRESTCLIENT_PAGECACHE_H
+#define QTRESTCLIENT_PAGECACHE_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <QtCore/qlist.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qurl.h>
+class QNetworkReply;
+
+namespace QtRestClient {
+
+class RequestBuilder;
+
+template<typename T>
+class Paging;
+
+//! @private
+class Q_RESTCLIENT_EXPORT PageCacheEntry
+{
+	Q_DISABLE_COPY(PageCacheEntry)
+
+public:
+	PageCacheEntry(int typeId, const QList<QPointer<QObject>> &guards);
+	virtual ~PageCacheEntry();
+
+	int typeId() const;
+	bool isAlive() const;
+
+	static bool isAlive(const QList<QPointer<QObject>> &guards);
+	static QNetworkReply *createReply(const RequestBuilder &builder, const QList<QPointer<QObject>> &guards);
+
+private:
+	int _typeId;
+	QList<QPointer<QObject>> _guards;
+};
+
+class PageCachePrivate;
+//! A memory cache for deserialized pages, to navigate between pages without network requests
+class Q_RESTCLIENT_EXPORT PageCache : public QObject
+{
+	Q_OBJECT
+	friend class PageCachePrivate;
+
+	//! The maximum number of pages kept in the cache
+	Q_PROPERTY(int maxPages READ maxPages WRITE setMaxPages NOTIFY maxPagesChanged)
+	//! The number of seconds a page is served from the cache
+	Q_PROPERTY(int maxAge READ maxAge WRITE setMaxAge NOTIFY maxAgeChanged)
+
+public:
+	//! Creates an empty cache
+	explicit PageCache(QObject *parent = nullptr);
+	~PageCache();
+
+	//! @readAcFn{PageCache::maxPages}
+	int maxPages() const;
+	//! @readAcFn{PageCache::maxAge}
+	int maxAge() const;
+
+	//! Returns the number of pages currently in the cache
+	int size() const;
+	//! Returns true, if the cache holds a page for the given URL, that has not expired
+	bool contains(const QUrl &url) const;
+
+	//! Returns the cached page for the given URL, or an invalid paging if there is none
+	template<typename T>
+	Paging<T> find(const QUrl &url) const;
+	//! Stores the page for the given URL, replacing any page that was cached for it
+	template<typename T>
+	void insert(const QUrl &url, const Paging<T> &paging);
+
+public Q_SLOTS:
+	//! Removes the page for the given URL from the cache
+	void remove(const QUrl &url);
+	//! Removes all pages from the cache
+	void clear();
+
+	//! @writeAcFn{PageCache::maxPages}
+	void setMaxPages(int maxPages);
+	//! @writeAcFn{PageCache::maxAge}
+	void setMaxAge(int maxAge);
+
+Q_SIGNALS:
+	//! @notifyAcFn{PageCache::maxPages}
+	void maxPagesChanged(int maxPages, QPrivateSignal);
+	//! @notifyAcFn{PageCache::maxAge}
+	void maxAgeChanged(int maxAge, QPrivateSignal);
+
+private:
+	QScopedPointer<PageCachePrivate> d;
+
+	QSharedPointer<PageCacheEntry> findEntry(const QUrl &url, int typeId) const;
+	void insertEntry(const QUrl &url, const QSharedPointer<PageCacheEntry> &entry);
+};
+
+}
+
+#endif // QTRESTCLIENT_PAGECACHE_H
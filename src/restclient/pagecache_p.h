@@ -0,0 +1,36 @@
+#ifndef QTRESTCLIENT_PAGECACHE_P_H
+#define QTRESTCLIENT_PAGECACHE_P_H
+
+#include "pagecache.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT PageCachePrivate
+{
+	friend class PageCache;
+
+public:
+	struct Entry {
+		QSharedPointer<PageCacheEntry> entry;
+		QElapsedTimer age;
+	};
+
+	int maxPages;
+	int maxAge;
+	QHash<QUrl, Entry> entries;
+	QList<QUrl> recentlyUsed;
+
+	PageCachePrivate();
+
+	bool isExpired(const Entry &entry) const;
+	void touch(const QUrl &url);
+	void evict();
+};
+
+}
+
+#endif // QTRESTCLIENT_PAGECACHE_P_H
@@ -3,6 +3,10 @@
 
 #include "QtRestClient/paging_fwd.h"
 #include "QtRestClient/genericrestreply.h"
+#include "QtRestClient/pagecache.h"
+#include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/qsharedpointer.h>
 
 // ------------- Generic Implementation -------------
@@ -20,6 +24,53 @@ public:
 	QSharedPointer<IPaging> iPaging;
 	QList<T> data;
 	RestClient *client;
+	QSharedPointer<QObject> owner;
+};
+
+//! @private
+template <typename T>
+class PagingIterateState
+{
+public:
+	std::function<bool(T, int)> iterator;
+	std::function<void(QString, int, RestReply::ErrorType)> errorHandler;
+	RestClient *client;
+	int maxConcurrent;
+	bool ordered;
+	int to;
+	int from;
+
+	QList<QPair<int, QUrl>> pages;
+	int nextRequest = 0;
+	int nextDeliver = 0;
+	QHash<int, QPointer<RestReply>> running;
+	QMap<int, Paging<T>> buffered;
+	bool finished = false;
+};
+
+//! @private
+template <typename T>
+class PagingCollectState
+{
+public:
+	std::function<void(QList<T>, bool)> handler;
+	std::function<void(QString, int, RestReply::ErrorType)> errorHandler;
+	int maxItems;
+	qint64 maxBytes;
+	qint64 receivedBytes;
+
+	QList<T> items;
+	QList<Paging<T>> ownerPages;
+};
+
+//! @private
+template <typename T>
+class PagingCacheEntry : public PageCacheEntry
+{
+public:
+	PagingCacheEntry(const Paging<T> &paging);
+
+	Paging<T> paging;
 };
 
 template<typename T>
@@ -39,6 +90,9 @@ Paging<T>::Paging(IPaging *iPaging, const QList<T> &data, RestClient *client) :
 	d->iPaging.reset(iPaging);
 	d->data = data;
 	d->client = client;
+	//one shared parent, deleted with the last copy, instead of one deleteLater per item
+	if(client && client->pagingOwnsItems())
+		d->owner = MetaComponent<T>::adoptAll(d->data);
 }
 
 template<typename T>
@@ -75,12 +129,9 @@ template<typename T>
 template<typename EO>
 GenericRestReply<Paging<T>, EO> *Paging<T>::next() const
 {
-	if(d->iPaging->hasNext()) {
-		auto reply = d->client->builder()
-				.updateFromRelativeUrl(d->iPaging->next(), true)
-				.send();
-		return new GenericRestReply<Paging<T>, EO>(reply, d->client, d->client);
-	} else
+	if(d->iPaging->hasNext())
+		return requestPage<EO>(d->iPaging->next());
+	else
 		return nullptr;
 }
 
@@ -100,12 +151,9 @@ template<typename T>
 template<typename EO>
 GenericRestReply<Paging<T>, EO> *Paging<T>::previous() const
 {
-	if(d->iPaging->hasPrevious()) {
-		auto reply = d->client->builder()
-				.updateFromRelativeUrl(d->iPaging->previous(), true)
-				.send();
-		return new GenericRestReply<Paging<T>, EO>(reply, d->client, d->client);
-	} else
+	if(d->iPaging->hasPrevious())
+		return requestPage<EO>(d->iPaging->previous());
+	else
 		return nullptr;
 }
 
@@ -127,26 +175,25 @@ void Paging<T>::iterate(std::function<bool(T, int)> iterator, std::function<void
 {
 	Q_ASSERT(from >= d->iPaging->offset());
 
+	//request the next page before handling this one, if enabled
+	auto max = iterateMax(to);
+	auto prefetched = prefetchNext<EO>(max);
+
 	auto index = internalIterate(iterator, to ,from);
-	if(index < 0)
+	if(index < 0) {
+		if(prefetched)
+			prefetched->abort();
 		return;
-
-	//calc total limit -> only if supports indexes
-	int max = INT_MAX;
-	if(d->iPaging->offset() >= 0) {
-		if(to >= 0)
-			max = qMin(to, d->iPaging->total());
-		else
-			max = d->iPaging->total();
 	}
 
 	//continue to the next one
 	if(index < max && d->iPaging->hasNext()) {
-		next()->onSucceeded([=](int, Paging<T> paging) {
+		(prefetched ? prefetched : next<EO>())->onSucceeded([=](int, Paging<T> paging) {
 				  paging.iterate(iterator, errorHandler, failureTransformer, to, index);
 			  })
 			  ->onAllErrors(errorHandler, failureTransformer);
-	}
+	} else if(prefetched)
+		prefetched->abort();
 }
 
 template<typename T>
@@ -155,28 +202,146 @@ void Paging<T>::iterate(std::function<bool(T, int)> iterator, std::function<void
 {
 	Q_ASSERT(from >= d->iPaging->offset());
 
+	//request the next page before handling this one, if enabled
+	auto max = iterateMax(to);
+	auto prefetched = prefetchNext<EO>(max);
+
 	auto index = internalIterate(iterator, to ,from);
-	if(index < 0)
+	if(index < 0) {
+		if(prefetched)
+			prefetched->abort();
 		return;
-
-	//calc total limit -> only if supports indexes
-	int max = INT_MAX;
-	if(d->iPaging->offset() >= 0) {
-		if(to >= 0)
-			max = qMin(to, d->iPaging->total());
-		else
-			max = d->iPaging->total();
 	}
 
 	//continue to the next one
 	if(index < max && d->iPaging->hasNext()) {
-		next()->onSucceeded([=](int, Paging<T> paging) {
+		(prefetched ? prefetched : next<EO>())->onSucceeded([=](int, Paging<T> paging) {
 				  paging.iterate(iterator, failureHandler, errorHandler, exceptionHandler, to, index);
 			  })
 			  ->onFailed(failureHandler)
 			  ->onError(errorHandler)
 			  ->onSerializeException(exceptionHandler);
+	} else if(prefetched)
+		prefetched->abort();
+}
+
+template<typename T>
+template<typename EO>
+void Paging<T>::iterateParallel(std::function<bool(T, int)> iterator, std::function<void(QString, int, RestReply::ErrorType)> errorHandler, int maxConcurrent, bool ordered, int to, int from) const
+{
+	Q_ASSERT(from >= d->iPaging->offset());
+
+	//calc the urls of all remaining pages -> only if supports indexes and total
+	auto offset = d->iPaging->offset();
+	auto pageSize = d->data.size();
+	auto max = iterateMax(to);
+	QList<QPair<int, QUrl>> pages;
+	if(d->client &&
+	   offset >= 0 &&
+	   pageSize > 0 &&
+	   d->iPaging->total() < INT_MAX &&
+	   d->iPaging->hasNext()) {
+		for(auto pageOffset = offset + pageSize; pageOffset < max; pageOffset += pageSize) {
+			if(pageOffset + pageSize <= from)
+				continue;
+			auto url = d->client->pagingFactory()->pageUrl(d->iPaging.data(), pageOffset);
+			if(!url.isValid()) {
+				pages.clear();
+				break;
+			}
+			pages.append({pageOffset, url});
+		}
+	}
+
+	//fall back to the sequential iteration if the urls are unknown
+	if(pages.isEmpty()) {
+		iterate<EO>(iterator, errorHandler, {}, to, from);
+		return;
+	}
+
+	QSharedPointer<PagingIterateState<T>> state(new PagingIterateState<T>());
+	state->iterator = iterator;
+	state->errorHandler = errorHandler;
+	state->client = d->client;
+	state->maxConcurrent = qMax(1, maxConcurrent);
+	state->ordered = ordered;
+	state->to = to;
+	state->from = from;
+	state->pages = pages;
+	fetchPages<EO>(state);
+
+	//handle this page while the others are downloading
+	if(internalIterate(iterator, to, from) < 0)
+		cancelIterate(state);
+}
+
+template<typename T>
+template<typename EO>
+void Paging<T>::collectAll(std::function<void(QList<T>, bool)> handler, std::function<void(QString, int, RestReply::ErrorType)> errorHandler, int maxItems, qint64 maxBytes) const
+{
+	startCollect<EO>(handler, errorHandler, maxItems, maxBytes, 0);
+}
+
+template<typename T>
+template<typename EO>
+void Paging<T>::startCollect(std::function<void(QList<T>, bool)> handler, std::function<void(QString, int, RestReply::ErrorType)> errorHandler, int maxItems, qint64 maxBytes, qint64 receivedBytes) const
+{
+	QSharedPointer<PagingCollectState<T>> state(new PagingCollectState<T>());
+	state->handler = handler;
+	state->errorHandler = errorHandler;
+	state->maxItems = maxItems;
+	state->maxBytes = maxBytes;
+	state->receivedBytes = receivedBytes;
+
+	//allocate the list once, if the size of the collection is known
+	if(d->iPaging->offset() >= 0 && d->iPaging->total() != INT_MAX) {
+		auto expected = d->iPaging->total() - d->iPaging->offset();
+		if(maxItems >= 0)
+			expected = qMin(expected, maxItems);
+		state->items.reserve(qMax(expected, 0));
+	}
+
+	collectPages<EO>(state, *this);
+}
+
+template<typename T>
+template<typename EO>
+void Paging<T>::collectPages(const QSharedPointer<PagingCollectState<T>> &state, const Paging<T> &paging)
+{
+	auto items = paging.items();
+	auto count = items.size();
+	if(state->maxItems >= 0)
+		count = qMin(count, state->maxItems - state->items.size());
+	for(auto i = 0; i < items.size(); i++) {
+		if(i < count)
+			state->items.append(items[i]);
+		else if(!paging.ownsItems())
+			MetaComponent<T>::deleteLater(items[i]);
 	}
+	//owned items live as long as their page
+	if(paging.ownsItems())
+		state->ownerPages.append(paging);
+
+	auto limitReached = state->maxItems >= 0 && state->items.size() >= state->maxItems;
+	auto budgetReached = state->maxBytes >= 0 && state->receivedBytes >= state->maxBytes;
+	if(limitReached || budgetReached || !paging.hasNext()) {
+		state->handler(state->items, !paging.hasNext() && count == items.size());
+		return;
+	}
+
+	auto reply = paging.template next<EO>();
+	reply->onSucceeded([state, reply](int, Paging<T> nextPaging) {
+		state->receivedBytes += reply->metrics().bytesReceived();
+		collectPages<EO>(state, nextPaging);
+	});
+	reply->onAllErrors([state](QString error, int code, RestReply::ErrorType type) {
+		if(state->ownerPages.isEmpty())
+			MetaComponent<T>::deleteAllLater(state->items);
+		state->items.clear();
+		state->ownerPages.clear();
+		if(state->errorHandler)
+			state->errorHandler(error, code, type);
+	});
 }
 
 template<typename T>
@@ -185,12 +350,147 @@ QVariantMap Paging<T>::properties() const
 	return d->iPaging->properties();
 }
 
+template<typename T>
+bool Paging<T>::ownsItems() const
+{
+	return !d->owner.isNull();
+}
+
 template<typename T>
 void Paging<T>::deleteAllItems() const
 {
+	if(d->owner)
+		return;
 	MetaComponent<T>::deleteAllLater(d->data);
 }
 
+template<typename T>
+int Paging<T>::iterateMax(int to) const
+{
+	//calc total limit -> only if supports indexes
+	int max = INT_MAX;
+	if(d->iPaging->offset() >= 0) {
+		if(to >= 0)
+			max = qMin(to, d->iPaging->total());
+		else
+			max = d->iPaging->total();
+	}
+	return max;
+}
+
+template<typename T>
+template<typename EO>
+GenericRestReply<Paging<T>, EO> *Paging<T>::requestPage(const QUrl &url) const
+{
+	auto builder = d->client->builder().updateFromRelativeUrl(url, true);
+	auto cache = d->client->pageCache();
+	if(!cache)
+		return new GenericRestReply<Paging<T>, EO>(builder.send(), d->client, d->client);
+
+	//serve known pages without network and deserialization
+	auto cacheUrl = builder.buildUrl();
+	auto cached = cache->find<T>(cacheUrl);
+	//pages of other clients were loaded with their credentials
+	if(cached.isValid() && cached.d->client == d->client) {
+		//the reply completes later, so the items are checked again before it is delivered
+		auto guards = MetaComponent<T>::guardAll(cached.items());
+		auto reply = new GenericRestReply<Paging<T>, EO>(PageCacheEntry::createReply(builder, guards), d->client, d->client);
+		reply->cacheUrl = cacheUrl;
+		reply->cachedPaging = cached;
+		reply->cachedGuards = guards;
+		return reply;
+	} else {
+		auto reply = new GenericRestReply<Paging<T>, EO>(builder.send(), d->client, d->client);
+		reply->cacheUrl = cacheUrl;
+		return reply;
+	}
+}
+
+template<typename T>
+template<typename EO>
+GenericRestReply<Paging<T>, EO> *Paging<T>::prefetchNext(int max) const
+{
+	if(!d->client || !d->client->pagingPrefetch() || !d->iPaging->hasNext())
+		return nullptr;
+	//skip if this page already reaches the limit
+	auto offset = d->iPaging->offset();
+	if(offset >= 0 && offset + d->data.size() >= max)
+		return nullptr;
+	return next<EO>();
+}
+
+template<typename T>
+template<typename EO>
+void Paging<T>::fetchPages(const QSharedPointer<PagingIterateState<T>> &state)
+{
+	while(!state->finished &&
+		  state->running.size() < state->maxConcurrent &&
+		  state->nextRequest < state->pages.size()) {
+		auto page = state->pages[state->nextRequest++];
+		auto pageOffset = page.first;
+		auto reply = new GenericRestReply<Paging<T>, EO>(state->client->builder()
+														 .updateFromRelativeUrl(page.second, true)
+														 .send(),
+														 state->client,
+														 state->client);
+		state->running.insert(pageOffset, reply);
+		reply->onSucceeded([state, pageOffset](int, Paging<T> paging) {
+			state->running.remove(pageOffset);
+			if(state->finished) {
+				paging.deleteAllItems();
+				return;
+			}
+			state->buffered.insert(pageOffset, paging);
+			deliverPages(state);
+			fetchPages<EO>(state);
+		});
+		reply->onAllErrors([state, pageOffset](QString error, int code, RestReply::ErrorType type) {
+			state->running.remove(pageOffset);
+			if(state->finished)
+				return;
+			cancelIterate(state);
+			if(state->errorHandler)
+				state->errorHandler(error, code, type);
+		});
+	}
+}
+
+template<typename T>
+void Paging<T>::deliverPages(const QSharedPointer<PagingIterateState<T>> &state)
+{
+	while(!state->finished && !state->buffered.isEmpty()) {
+		Paging<T> paging;
+		if(state->ordered) {
+			auto pageOffset = state->pages[state->nextDeliver].first;
+			if(!state->buffered.contains(pageOffset))
+				break;
+			paging = state->buffered.take(pageOffset);
+		} else
+			paging = state->buffered.take(state->buffered.firstKey());
+
+		state->nextDeliver++;
+		if(paging.internalIterate(state->iterator, state->to, state->from) < 0)
+			cancelIterate(state);
+		else if(state->nextDeliver == state->pages.size())
+			state->finished = true;
+	}
+}
+
+template<typename T>
+void Paging<T>::cancelIterate(const QSharedPointer<PagingIterateState<T>> &state)
+{
+	state->finished = true;
+	auto running = state->running;
+	state->running.clear();
+	for(auto reply : running) {
+		if(reply)
+			reply->abort();
+	}
+	for(auto paging : state->buffered)
+		paging.deleteAllItems();
+	state->buffered.clear();
+}
+
 template<typename T>
 int Paging<T>::internalIterate(std::function<bool (T, int)> iterator, int to, int from) const
 {
@@ -209,7 +509,7 @@ int Paging<T>::internalIterate(std::function<bool (T, int)> iterator, int to, in
 	}
 
 	//delete unused items caused by from
-	for(auto j = 0; j < start; j++)
+	for(auto j = 0; !d->owner && j < start; j++)
 		MetaComponent<T>::deleteLater(d->data.value(j));
 
 	//iterate over used items
@@ -225,7 +525,7 @@ int Paging<T>::internalIterate(std::function<bool (T, int)> iterator, int to, in
 	}
 
 	//delete all unused items caused by to
-	for(auto j = i; j < count; j++)
+	for(auto j = i; !d->owner && j < count; j++)
 		MetaComponent<T>::deleteLater(d->data.value(j));
 
 	if(canceled)
@@ -241,7 +541,8 @@ PagingData<T>::PagingData() :
 	QSharedData(),
 	iPaging(nullptr),
 	data(),
-	client(nullptr)
+	client(nullptr),
+	owner()
 {}
 
 template<typename T>
@@ -249,9 +550,38 @@ PagingData<T>::PagingData(const PagingData &other) :
 	QSharedData(other),
 	iPaging(other.iPaging),
 	data(other.data),
-	client(other.client)
+	client(other.client),
+	owner(other.owner)
 {}
 
+template<typename T>
+PagingCacheEntry<T>::PagingCacheEntry(const Paging<T> &paging) :
+	PageCacheEntry(qMetaTypeId<T>(), MetaComponent<T>::guardAll(paging.items())),
+	paging(paging)
+{}
+
+template<typename T>
+Paging<T> PageCache::find(const QUrl &url) const
+{
+	auto entry = findEntry(url, qMetaTypeId<T>());
+	if(entry)
+		return entry.staticCast<PagingCacheEntry<T>>()->paging;
+	else
+		return {};
 }
 
+template<typename T>
+void PageCache::insert(const QUrl &url, const Paging<T> &paging)
+{
+	//QObject items that are not owned by the paging can be deleted via any copy of it
+	if(!paging.isValid() ||
+	   (std::is_base_of<QObject, typename std::remove_pointer<T>::type>::value && !paging.ownsItems()))
+		return;
+	insertEntry(url, QSharedPointer<PagingCacheEntry<T>>::create(paging));
+}
+
+}
+
+#include "QtRestClient/pagingstream.h"
+
 #endif // QTRESTCLIENT_PAGING_H
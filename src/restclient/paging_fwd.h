@@ -10,6 +10,7 @@
 
 #include <QtJsonSerializer/qjsonserializerexception.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qsharedpointer.h>
 #include <functional>
 
 namespace QtRestClient {
@@ -20,6 +21,18 @@ class GenericRestReply;
 template<typename T>
 class PagingData;
 
+template<typename T>
+class PagingIterateState;
+
+template<typename T>
+class PagingCollectState;
+
+template<typename T, typename EO>
+class PagingStream;
+
+template<typename T, typename EO>
+class PagingModel;
+
 //! A class to access generic paging objects
 template<typename T>
 class Paging
@@ -78,16 +91,60 @@ public:
 				 int to = -1,
 				 int from = 0) const;
 
+	//! Iterates over all paging objects, requesting the remaining pages in parallel
+	template<typename EO = QObject*>
+	void iterateParallel(std::function<bool(T, int)> iterator,
+						 std::function<void(QString, int, RestReply::ErrorType)> errorHandler = {},
+						 int maxConcurrent = 4,
+						 bool ordered = true,
+						 int to = -1,
+						 int from = 0) const;
+
+	//! Collects the items of this and all following pagings into one list
+	template<typename EO = QObject*>
+	void collectAll(std::function<void(QList<T>, bool)> handler,
+					std::function<void(QString, int, RestReply::ErrorType)> errorHandler = {},
+					int maxItems = -1,
+					qint64 maxBytes = -1) const;
+
+	//! Creates a pull based stream over the items of this and all following pagings
+	template<typename EO = QObject*>
+	PagingStream<T, EO> stream() const;
+
 	//! @copybrief IPaging::properties
 	QVariantMap properties() const;
 
+	//! Returns true, if the items are deleted together with the last copy of this paging
+	bool ownsItems() const;
 	//! Deletes all items this paging object is holding (QObjects only)
 	void deleteAllItems() const;
 
 private:
+	template<typename, typename>
+	friend class PagingModel;
+	template<typename, typename>
+	friend class GenericRestReply;
+
 	QSharedDataPointer<PagingData<T>> d;
 
 	int internalIterate(std::function<bool(T, int)> iterator, int from, int to) const;
+	int iterateMax(int to) const;
+	template<typename EO>
+	GenericRestReply<Paging<T>, EO> *requestPage(const QUrl &url) const;
+	template<typename EO>
+	GenericRestReply<Paging<T>, EO> *prefetchNext(int max) const;
+	template<typename EO>
+	static void fetchPages(const QSharedPointer<PagingIterateState<T>> &state);
+	static void deliverPages(const QSharedPointer<PagingIterateState<T>> &state);
+	static void cancelIterate(const QSharedPointer<PagingIterateState<T>> &state);
+	template<typename EO>
+	void startCollect(std::function<void(QList<T>, bool)> handler,
+					  std::function<void(QString, int, RestReply::ErrorType)> errorHandler,
+					  int maxItems,
+					  qint64 maxBytes,
+					  qint64 receivedBytes) const;
+	template<typename EO>
+	static void collectPages(const QSharedPointer<PagingCollectState<T>> &state, const Paging<T> &paging);
 };
 
 }
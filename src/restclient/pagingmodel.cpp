@@ -0,0 +1,208 @@
+#include "pagingmodel.h"
+#include "pagingmodel_p.h"
+
+#include <algorithm>
+using namespace QtRestClient;
+
+PagingModelBase::PagingModelBase(QObject *parent) :
+	QAbstractListModel(parent),
+	d(new PagingModelBasePrivate())
+{}
+
+PagingModelBase::~PagingModelBase() {}
+
+int PagingModelBase::maxLoadedPages() const
+{
+	return d->maxLoadedPages;
+}
+
+int PagingModelBase::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : d->rowCount;
+}
+
+QVariant PagingModelBase::data(const QModelIndex &index, int role) const
+{
+	if(!index.isValid() || index.parent().isValid() || index.row() >= d->rowCount)
+		return {};
+
+	auto pageRow = 0;
+	auto page = d->pageOf(index.row(), pageRow);
+	if(!d->loaded.contains(page)) {
+		//unloaded pages are requested again once a view needs them, unless that failed before
+		if(!d->failed.contains(page))
+			const_cast<PagingModelBase*>(this)->reloadPage(page);
+		return {};
+	}
+	d->touch(page);
+	return pageData(page, pageRow, role);
+}
+
+bool PagingModelBase::canFetchMore(const QModelIndex &parent) const
+{
+	return !parent.isValid() && canFetchNextPage();
+}
+
+void PagingModelBase::fetchMore(const QModelIndex &parent)
+{
+	if(!parent.isValid())
+		fetchNextPage();
+}
+
+QHash<int, QByteArray> PagingModelBase::roleNames() const
+{
+	QHash<int, QByteArray> roles;
+	roles.insert(ModelDataRole, "modelData");
+	auto metaObject = itemMetaObject();
+	for(auto i = 0; i < metaObject->propertyCount(); i++)
+		roles.insert(ModelDataRole + 1 + i, metaObject->property(i).name());
+	return roles;
+}
+
+bool PagingModelBase::isRowLoaded(int row) const
+{
+	if(row < 0 || row >= d->rowCount)
+		return false;
+	auto pageRow = 0;
+	return d->loaded.contains(d->pageOf(row, pageRow));
+}
+
+int PagingModelBase::loadedPages() const
+{
+	return d->loaded.size();
+}
+
+void PagingModelBase::setMaxLoadedPages(int maxLoadedPages)
+{
+	maxLoadedPages = qMax(0, maxLoadedPages);
+	if(d->maxLoadedPages == maxLoadedPages)
+		return;
+
+	d->maxLoadedPages = maxLoadedPages;
+	unloadPages();
+	emit maxLoadedPagesChanged(d->maxLoadedPages, {});
+}
+
+void PagingModelBase::retryFailedPages()
+{
+	//views request the pages again via data()
+	auto pages = d->failed;
+	d->failed.clear();
+	for(auto page : pages) {
+		auto size = d->pageSize(page);
+		if(size > 0)
+			emit dataChanged(index(d->pageStarts[page]), index(d->pageStarts[page] + size - 1));
+	}
+}
+
+void PagingModelBase::beginResetPages()
+{
+	beginResetModel();
+	d->rowCount = 0;
+	d->pageStarts.clear();
+	d->recentlyUsed.clear();
+	d->loaded.clear();
+	d->failed.clear();
+}
+
+void PagingModelBase::endResetPages()
+{
+	endResetModel();
+}
+
+int PagingModelBase::addPage(int size)
+{
+	auto page = d->pageStarts.size();
+	d->pageStarts.append(d->rowCount);
+	d->rowCount += size;
+	d->loaded.insert(page);
+	d->touch(page);
+	return page;
+}
+
+int PagingModelBase::beginAppendPage(int size)
+{
+	if(size > 0)
+		beginInsertRows({}, d->rowCount, d->rowCount + size - 1);
+	return addPage(size);
+}
+
+void PagingModelBase::endAppendPage()
+{
+	if(d->pageSize(d->pageStarts.size() - 1) > 0)
+		endInsertRows();
+	unloadPages();
+}
+
+void PagingModelBase::pageReloaded(int page)
+{
+	d->failed.remove(page);
+	d->loaded.insert(page);
+	d->touch(page);
+	auto size = d->pageSize(page);
+	if(size > 0)
+		emit dataChanged(index(d->pageStarts[page]), index(d->pageStarts[page] + size - 1));
+	unloadPages();
+}
+
+void PagingModelBase::pageReloadFailed(int page, const QString &errorString, int errorCode, RestReply::ErrorType errorType)
+{
+	d->failed.insert(page);
+	emit fetchError(errorString, errorCode, errorType, {});
+}
+
+void PagingModelBase::reportError(const QString &errorString, int errorCode, RestReply::ErrorType errorType)
+{
+	emit fetchError(errorString, errorCode, errorType, {});
+}
+
+void PagingModelBase::unloadPages()
+{
+	//unload the least recently used pages first, skipping those that can't be loaded again
+	if(d->maxLoadedPages == 0)
+		return;
+	for(auto i = 0; i < d->recentlyUsed.size() && d->loaded.size() > d->maxLoadedPages;) {
+		auto page = d->recentlyUsed[i];
+		if(unloadPage(page)) {
+			d->recentlyUsed.removeAt(i);
+			d->loaded.remove(page);
+		} else
+			i++;
+	}
+}
+
+// ------------- Private Implementation -------------
+
+PagingModelBasePrivate::PagingModelBasePrivate() :
+	maxLoadedPages(10),
+	rowCount(0),
+	pageStarts(),
+	recentlyUsed(),
+	loaded(),
+	failed()
+{}
+
+int PagingModelBasePrivate::pageOf(int row, int &pageRow) const
+{
+	//the last page that starts at or before the row
+	auto it = std::upper_bound(pageStarts.constBegin(), pageStarts.constEnd(), row);
+	auto page = static_cast<int>(std::distance(pageStarts.constBegin(), it)) - 1;
+	pageRow = row - pageStarts[page];
+	return page;
+}
+
+int PagingModelBasePrivate::pageSize(int page) const
+{
+	if(page + 1 < pageStarts.size())
+		return pageStarts[page + 1] - pageStarts[page];
+	else
+		return rowCount - pageStarts[page];
+}
+
+void PagingModelBasePrivate::touch(int page)
+{
+	if(!recentlyUsed.isEmpty() && recentlyUsed.last() == page)
+		return;
+	recentlyUsed.removeOne(page);
+	recentlyUsed.append(page);
+}
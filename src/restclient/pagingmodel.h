@@ -0,0 +1,309 @@
+#ifndef QTRESTCLIENT_PAGINGMODEL_H
+#define QTRESTCLIENT_PAGINGMODEL_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/paging.h"
+
+#include <QtCore/qabstractitemmodel.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qscopedpointer.h>
+
+namespace QtRestClient {
+
+class PagingModelBasePrivate;
+//! The non generic base of PagingModel, with the model logic and the properties
+class Q_RESTCLIENT_EXPORT PagingModelBase : public QAbstractListModel
+{
+	Q_OBJECT
+	friend class PagingModelBasePrivate;
+
+	//! The maximum number of pages to keep loaded at once
+	Q_PROPERTY(int maxLoadedPages READ maxLoadedPages WRITE setMaxLoadedPages NOTIFY maxLoadedPagesChanged)
+
+public:
+	//! The roles of the model. All properties of the item type follow after ModelDataRole
+	enum Roles {
+		ModelDataRole = Qt::UserRole //!< The item itself
+	};
+	Q_ENUM(Roles)
+
+	//! Constructor
+	explicit PagingModelBase(QObject *parent = nullptr);
+	~PagingModelBase();
+
+	//! @readAcFn{PagingModelBase::maxLoadedPages}
+	int maxLoadedPages() const;
+
+	//! @inherit{QAbstractListModel::rowCount}
+	int rowCount(const QModelIndex &parent = {}) const override;
+	//! @inherit{QAbstractListModel::data}
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	//! @inherit{QAbstractListModel::canFetchMore}
+	bool canFetchMore(const QModelIndex &parent) const override;
+	//! @inherit{QAbstractListModel::fetchMore}
+	void fetchMore(const QModelIndex &parent) override;
+	//! @inherit{QAbstractListModel::roleNames}
+	QHash<int, QByteArray> roleNames() const override;
+
+	//! Returns true, if the items of the given row are currently loaded
+	bool isRowLoaded(int row) const;
+	//! Returns the number of pages that are currently loaded
+	int loadedPages() const;
+
+public Q_SLOTS:
+	//! @writeAcFn{PagingModelBase::maxLoadedPages}
+	void setMaxLoadedPages(int maxLoadedPages);
+	//! Allows views to request the pages that failed to load again
+	void retryFailedPages();
+
+Q_SIGNALS:
+	//! Is emitted if loading a page did not succeed
+	void fetchError(const QString &errorString, int errorCode, RestReply::ErrorType errorType, QPrivateSignal);
+
+	//! @notifyAcFn{PagingModelBase::maxLoadedPages}
+	void maxLoadedPagesChanged(int maxLoadedPages, QPrivateSignal);
+
+protected:
+	//! Returns the meta object of the item type
+	virtual const QMetaObject *itemMetaObject() const = 0;
+	//! Returns the data of an item of a loaded page
+	virtual QVariant pageData(int page, int pageRow, int role) const = 0;
+	//! Returns true, if another page can be appended
+	virtual bool canFetchNextPage() const = 0;
+	//! Starts loading the page after the last one
+	virtual void fetchNextPage() = 0;
+	//! Starts loading an unloaded page again
+	virtual void reloadPage(int page) = 0;
+	//! Frees the items of a page. Returns false, if the page cannot be loaded again
+	virtual bool unloadPage(int page) = 0;
+
+	//! Removes all pages and begins a model reset
+	void beginResetPages();
+	//! Ends a model reset
+	void endResetPages();
+	//! Adds a loaded page to the end, without notifying views. Returns the page index
+	int addPage(int size);
+	//! Begins to insert the rows of a new page. Returns the page index
+	int beginAppendPage(int size);
+	//! Ends inserting the rows of a page and unloads pages if there are too many
+	void endAppendPage();
+	//! Marks an unloaded page as loaded again and updates views
+	void pageReloaded(int page);
+	//! Marks an unloaded page as failed, so it is not requested again until retryFailedPages is called
+	void pageReloadFailed(int page, const QString &errorString, int errorCode, RestReply::ErrorType errorType);
+	//! Emits fetchError
+	void reportError(const QString &errorString, int errorCode, RestReply::ErrorType errorType);
+
+private:
+	QScopedPointer<PagingModelBasePrivate> d;
+
+	void unloadPages();
+};
+
+//! A list model that loads the pages of a paging on demand, and unloads those that were not used recently
+template <typename T, typename EO = QObject*>
+class PagingModel : public PagingModelBase
+{
+public:
+	//! Constructor
+	explicit PagingModel(QObject *parent = nullptr);
+	//! Creates a model that begins with the given paging
+	explicit PagingModel(const Paging<T> &paging, QObject *parent = nullptr);
+	~PagingModel();
+
+	//! Resets the model to begin with the given paging. The model takes ownership of its items
+	void setPaging(const Paging<T> &paging);
+	//! Returns the item at the given row, or a default constructed one if the row is not loaded
+	T item(int row) const;
+
+protected:
+	const QMetaObject *itemMetaObject() const override;
+	QVariant pageData(int page, int pageRow, int role) const override;
+	bool canFetchNextPage() const override;
+	void fetchNextPage() override;
+	void reloadPage(int page) override;
+	bool unloadPage(int page) override;
+
+private:
+	Paging<T> _last;
+	QHash<int, Paging<T>> _pages;
+	QHash<int, QUrl> _pageUrls;
+	QPointer<RestReply> _fetchReply;
+	QHash<int, QPointer<RestReply>> _reloadReplies;
+	int _generation;
+
+	void clearPages();
+};
+
+// ------------- Generic Implementation -------------
+
+template<typename T, typename EO>
+PagingModel<T, EO>::PagingModel(QObject *parent) :
+	PagingModelBase(parent),
+	_last(),
+	_pages(),
+	_pageUrls(),
+	_fetchReply(),
+	_reloadReplies(),
+	_generation(0)
+{}
+
+template<typename T, typename EO>
+PagingModel<T, EO>::PagingModel(const Paging<T> &paging, QObject *parent) :
+	PagingModel(parent)
+{
+	setPaging(paging);
+}
+
+template<typename T, typename EO>
+PagingModel<T, EO>::~PagingModel()
+{
+	//running replies see the model is gone and delete their items
+	clearPages();
+}
+
+template<typename T, typename EO>
+void PagingModel<T, EO>::setPaging(const Paging<T> &paging)
+{
+	beginResetPages();
+	clearPages();
+	_last = paging;
+	if(paging.isValid())
+		_pages.insert(addPage(paging.items().size()), paging);
+	endResetPages();
+}
+
+template<typename T, typename EO>
+T PagingModel<T, EO>::item(int row) const
+{
+	return PagingModelBase::data(index(row), ModelDataRole).template value<T>();
+}
+
+template<typename T, typename EO>
+const QMetaObject *PagingModel<T, EO>::itemMetaObject() const
+{
+	return MetaComponent<T>::metaObject();
+}
+
+template<typename T, typename EO>
+QVariant PagingModel<T, EO>::pageData(int page, int pageRow, int role) const
+{
+	auto items = _pages.value(page).items();
+	if(pageRow >= items.size())
+		return {};
+	if(role == Qt::DisplayRole || role == ModelDataRole)
+		return QVariant::fromValue(items[pageRow]);
+
+	auto metaObject = MetaComponent<T>::metaObject();
+	auto propertyIndex = role - ModelDataRole - 1;
+	if(propertyIndex < 0 || propertyIndex >= metaObject->propertyCount())
+		return {};
+	return MetaComponent<T>::readProperty(metaObject->property(propertyIndex), items[pageRow]);
+}
+
+template<typename T, typename EO>
+bool PagingModel<T, EO>::canFetchNextPage() const
+{
+	return !_fetchReply && _last.isValid() && _last.hasNext();
+}
+
+template<typename T, typename EO>
+void PagingModel<T, EO>::fetchNextPage()
+{
+	if(!canFetchNextPage())
+		return;
+
+	QPointer<PagingModel<T, EO>> self(this);
+	auto generation = _generation;
+	auto reply = _last.template next<EO>();
+	_fetchReply = reply;
+	reply->onSucceeded([self, generation](int, Paging<T> paging) {
+		if(!self || self->_generation != generation) {
+			paging.deleteAllItems();
+			return;
+		}
+		self->_fetchReply.clear();
+		self->_last = paging;
+		self->_pages.insert(self->beginAppendPage(paging.items().size()), paging);
+		self->endAppendPage();
+	});
+	reply->onAllErrors([self, generation](QString error, int code, RestReply::ErrorType type) {
+		if(!self || self->_generation != generation)
+			return;
+		self->_fetchReply.clear();
+		self->reportError(error, code, type);
+	});
+}
+
+template<typename T, typename EO>
+void PagingModel<T, EO>::reloadPage(int page)
+{
+	if(_reloadReplies.value(page) || !_pageUrls.contains(page))
+		return;
+
+	QPointer<PagingModel<T, EO>> self(this);
+	auto generation = _generation;
+	auto reply = _last.template requestPage<EO>(_pageUrls.value(page));
+	_reloadReplies.insert(page, reply);
+	reply->onSucceeded([self, generation, page](int, Paging<T> paging) {
+		if(!self || self->_generation != generation || !self->_pageUrls.contains(page)) {
+			paging.deleteAllItems();
+			return;
+		}
+		self->_reloadReplies.remove(page);
+		self->_pageUrls.remove(page);
+		self->_pages.insert(page, paging);
+		self->pageReloaded(page);
+	});
+	reply->onAllErrors([self, generation, page](QString error, int code, RestReply::ErrorType type) {
+		if(!self || self->_generation != generation)
+			return;
+		self->_reloadReplies.remove(page);
+		self->pageReloadFailed(page, error, code, type);
+	});
+}
+
+template<typename T, typename EO>
+bool PagingModel<T, EO>::unloadPage(int page)
+{
+	const auto paging = _pages.value(page);
+	if(!paging.isValid() || paging.offset() < 0)
+		return false;
+	//only pages that can be requested directly can be loaded again
+	auto url = paging.d->client->pagingFactory()->pageUrl(paging.d->iPaging.data(), paging.offset());
+	if(!url.isValid())
+		return false;
+
+	_pages.remove(page);
+	_pageUrls.insert(page, url);
+	//loading the page again must not return the unloaded items from the cache
+	if(auto cache = paging.d->client->pageCache())
+		cache->remove(paging.d->client->builder().updateFromRelativeUrl(url, true).buildUrl());
+	paging.deleteAllItems();
+	return true;
+}
+
+template<typename T, typename EO>
+void PagingModel<T, EO>::clearPages()
+{
+	_generation++;
+	if(_fetchReply)
+		_fetchReply->abort();
+	for(auto reply : _reloadReplies) {
+		if(reply)
+			reply->abort();
+	}
+	for(const auto &paging : _pages)
+		paging.deleteAllItems();
+
+	_last = {};
+	_pages.clear();
+	_pageUrls.clear();
+	_fetchReply.clear();
+	_reloadReplies.clear();
+}
+
+}
+
+#endif // QTRESTCLIENT_PAGINGMODEL_H
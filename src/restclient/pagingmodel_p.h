@@ -0,0 +1,33 @@
+#ifndef QTRESTCLIENT_PAGINGMODEL_P_H
+#define QTRESTCLIENT_PAGINGMODEL_P_H
+
+#include "pagingmodel.h"
+
+#include <QtCore/QList>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT PagingModelBasePrivate
+{
+	friend class PagingModelBase;
+
+public:
+	int maxLoadedPages;
+	int rowCount;
+	QVector<int> pageStarts;
+	QList<int> recentlyUsed;
+	QSet<int> loaded;
+	QSet<int> failed;
+
+	PagingModelBasePrivate();
+
+	int pageOf(int row, int &pageRow) const;
+	int pageSize(int page) const;
+	void touch(int page);
+};
+
+}
+
+#endif // QTRESTCLIENT_PAGINGMODEL_P_H
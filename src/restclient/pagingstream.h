@@ -0,0 +1,250 @@
+#ifndef QTRESTCLIENT_PAGINGSTREAM_H
+#define QTRESTCLIENT_PAGINGSTREAM_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/paging.h"
+
+#include <QtCore/qpointer.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qsharedpointer.h>
+#include <functional>
+
+namespace QtRestClient {
+
+//! @private
+template <typename T, typename EO>
+class PagingStreamState
+{
+public:
+	~PagingStreamState();
+
+	Paging<T> current;
+	QQueue<QPair<T, int>> buffer;
+	QPointer<RestReply> reply;
+	int requested = 0;
+	bool delivering = false;
+	bool finished = false;
+
+	std::function<void(T, int)> itemHandler;
+	std::function<void()> finishedHandler;
+	std::function<void(QString, int, RestReply::ErrorType)> errorHandler;
+
+	void take(const Paging<T> &paging);
+	void abort();
+};
+
+//! A pull based stream over the items of a paging and all pages after it
+template <typename T, typename EO = QObject*>
+class PagingStream
+{
+public:
+	//! Creates an invalid stream
+	PagingStream();
+	//! Creates a stream that begins with the items of the given paging
+	explicit PagingStream(const Paging<T> &paging);
+
+	//! Returns true, if the stream was created from a valid paging
+	bool isValid() const;
+	//! Returns true, if all items have been delivered, or the stream failed or was canceled
+	bool isFinished() const;
+	//! Returns the number of items that were requested, but not delivered yet
+	int pending() const;
+	//! Returns the number of items that are loaded, but not requested yet
+	int buffered() const;
+
+	//! Sets the handler to be called for every requested item, with its index
+	PagingStream<T, EO> &onItem(std::function<void(T, int)> handler);
+	//! Sets the handler to be called once the last item has been delivered
+	PagingStream<T, EO> &onFinished(std::function<void()> handler);
+	//! Sets the handler to be called if loading a page did not succeed
+	PagingStream<T, EO> &onError(std::function<void(QString, int, RestReply::ErrorType)> handler);
+
+	//! Requests count more items, loading the next page only if needed
+	void requestMore(int count = 1);
+	//! Stops the stream, aborting the running request and deleting buffered items
+	void cancel();
+
+private:
+	QSharedPointer<PagingStreamState<T, EO>> d;
+
+	static void deliver(const QSharedPointer<PagingStreamState<T, EO>> &state);
+	static void fetch(const QSharedPointer<PagingStreamState<T, EO>> &state);
+};
+
+// ------------- Generic Implementation -------------
+
+template<typename T>
+template<typename EO>
+PagingStream<T, EO> Paging<T>::stream() const
+{
+	return PagingStream<T, EO>(*this);
+}
+
+template<typename T, typename EO>
+PagingStream<T, EO>::PagingStream() :
+	d()
+{}
+
+template<typename T, typename EO>
+PagingStream<T, EO>::PagingStream(const Paging<T> &paging) :
+	d(paging.isValid() ? new PagingStreamState<T, EO>() : nullptr)
+{
+	if(d)
+		d->take(paging);
+}
+
+template<typename T, typename EO>
+bool PagingStream<T, EO>::isValid() const
+{
+	return !d.isNull();
+}
+
+template<typename T, typename EO>
+bool PagingStream<T, EO>::isFinished() const
+{
+	return !d || d->finished;
+}
+
+template<typename T, typename EO>
+int PagingStream<T, EO>::pending() const
+{
+	return d ? d->requested : 0;
+}
+
+template<typename T, typename EO>
+int PagingStream<T, EO>::buffered() const
+{
+	return d ? d->buffer.size() : 0;
+}
+
+template<typename T, typename EO>
+PagingStream<T, EO> &PagingStream<T, EO>::onItem(std::function<void(T, int)> handler)
+{
+	if(d)
+		d->itemHandler = handler;
+	return *this;
+}
+
+template<typename T, typename EO>
+PagingStream<T, EO> &PagingStream<T, EO>::onFinished(std::function<void()> handler)
+{
+	if(d)
+		d->finishedHandler = handler;
+	return *this;
+}
+
+template<typename T, typename EO>
+PagingStream<T, EO> &PagingStream<T, EO>::onError(std::function<void(QString, int, RestReply::ErrorType)> handler)
+{
+	if(d)
+		d->errorHandler = handler;
+	return *this;
+}
+
+template<typename T, typename EO>
+void PagingStream<T, EO>::requestMore(int count)
+{
+	if(!d || d->finished || count <= 0)
+		return;
+	d->requested += count;
+	auto state = d;//keep alive, even if a handler destroys this stream
+	deliver(state);
+}
+
+template<typename T, typename EO>
+void PagingStream<T, EO>::cancel()
+{
+	if(d)
+		d->abort();
+}
+
+template<typename T, typename EO>
+void PagingStream<T, EO>::deliver(const QSharedPointer<PagingStreamState<T, EO>> &state)
+{
+	//handlers may request more items -> the running loop picks them up
+	if(state->delivering)
+		return;
+	state->delivering = true;
+	while(!state->finished && state->requested > 0 && !state->buffer.isEmpty()) {
+		auto item = state->buffer.dequeue();
+		state->requested--;
+		if(state->itemHandler)
+			state->itemHandler(item.first, item.second);
+	}
+	state->delivering = false;
+
+	if(state->finished || !state->buffer.isEmpty())
+		return;
+	if(!state->current.hasNext()) {
+		state->finished = true;
+		if(state->finishedHandler)
+			state->finishedHandler();
+	} else if(state->requested > 0)
+		fetch(state);
+}
+
+template<typename T, typename EO>
+void PagingStream<T, EO>::fetch(const QSharedPointer<PagingStreamState<T, EO>> &state)
+{
+	if(state->reply)
+		return;
+
+	QWeakPointer<PagingStreamState<T, EO>> weakState = state;
+	auto reply = state->current.template next<EO>();
+	state->reply = reply;
+	reply->onSucceeded([weakState](int, Paging<T> paging) {
+		auto state = weakState.toStrongRef();
+		if(!state || state->finished) {
+			paging.deleteAllItems();
+			return;
+		}
+		state->reply.clear();
+		state->take(paging);
+		deliver(state);
+	});
+	reply->onAllErrors([weakState](QString error, int code, RestReply::ErrorType type) {
+		auto state = weakState.toStrongRef();
+		if(!state || state->finished)
+			return;
+		state->reply.clear();
+		state->abort();
+		if(state->errorHandler)
+			state->errorHandler(error, code, type);
+	});
+}
+
+template<typename T, typename EO>
+PagingStreamState<T, EO>::~PagingStreamState()
+{
+	abort();
+}
+
+template<typename T, typename EO>
+void PagingStreamState<T, EO>::take(const Paging<T> &paging)
+{
+	auto offset = paging.offset();
+	auto items = paging.items();
+	for(auto i = 0; i < items.size(); i++)
+		buffer.enqueue({items[i], offset >= 0 ? offset + i : -1});
+	current = paging;
+}
+
+template<typename T, typename EO>
+void PagingStreamState<T, EO>::abort()
+{
+	finished = true;
+	requested = 0;
+	if(reply) {
+		auto runningReply = reply;
+		reply.clear();
+		runningReply->abort();
+	}
+	if(current.ownsItems())
+		buffer.clear();
+	while(!buffer.isEmpty())
+		MetaComponent<T>::deleteLater(buffer.dequeue().first);
+}
+
+}
+
+#endif // QTRESTCLIENT_PAGINGSTREAM_H
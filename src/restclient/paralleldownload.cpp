@@ -0,0 +1,332 @@
+#include "paralleldownload.h"
+#include "paralleldownload_p.h"
+
+using namespace QtRestClient;
+
+ParallelDownload::ParallelDownload(const RequestBuilder &builder, const QString &filePath, QObject *parent) :
+	QObject(parent),
+	d(new ParallelDownloadPrivate(builder, filePath, this))
+{}
+
+ParallelDownload::~ParallelDownload() {}
+
+QString ParallelDownload::filePath() const
+{
+	return d->file.fileName();
+}
+
+int ParallelDownload::parallelism() const
+{
+	return d->parallelism;
+}
+
+qint64 ParallelDownload::minimumRangeSize() const
+{
+	return d->minimumRangeSize;
+}
+
+bool ParallelDownload::isRanged() const
+{
+	return d->ranged;
+}
+
+bool ParallelDownload::isRunning() const
+{
+	return d->probeReply || d->activeRanges > 0;
+}
+
+qint64 ParallelDownload::bytesReceived() const
+{
+	return d->received;
+}
+
+qint64 ParallelDownload::bytesTotal() const
+{
+	return d->total;
+}
+
+void ParallelDownload::start()
+{
+	if(isRunning())
+		return;
+	d->startProbe();
+}
+
+void ParallelDownload::abort()
+{
+	if(!isRunning())
+		return;
+	d->fail(tr("Operation canceled"), QNetworkReply::OperationCanceledError);
+}
+
+void ParallelDownload::setParallelism(int parallelism)
+{
+	parallelism = qMax(parallelism, 1);
+	if (d->parallelism == parallelism)
+		return;
+
+	d->parallelism = parallelism;
+	emit parallelismChanged(parallelism, {});
+}
+
+void ParallelDownload::setMinimumRangeSize(qint64 minimumRangeSize)
+{
+	if (d->minimumRangeSize == minimumRangeSize)
+		return;
+
+	d->minimumRangeSize = minimumRangeSize;
+	emit minimumRangeSizeChanged(minimumRangeSize, {});
+}
+
+// ------------- Private Implementation -------------
+
+const QByteArray ParallelDownloadPrivate::AcceptRangesHeader("Accept-Ranges");
+const QByteArray ParallelDownloadPrivate::RangeHeader("Range");
+const QByteArray ParallelDownloadPrivate::IfRangeHeader("If-Range");
+const QByteArray ParallelDownloadPrivate::ETagHeader("ETag");
+
+ParallelDownloadPrivate::ParallelDownloadPrivate(const RequestBuilder &builder, const QString &filePath, ParallelDownload *q_ptr) :
+	QObject(q_ptr),
+	builder(builder),
+	file(filePath),
+	parallelism(4),
+	minimumRangeSize(1024 * 1024),
+	probeReply(),
+	etag(),
+	ranged(false),
+	received(0),
+	total(-1),
+	ranges(),
+	nextRange(0),
+	activeRanges(0),
+	q(q_ptr)
+{}
+
+ParallelDownloadPrivate::~ParallelDownloadPrivate()
+{
+	cleanup();
+}
+
+void ParallelDownloadPrivate::startProbe()
+{
+	received = 0;
+	total = -1;
+	ranged = false;
+	etag.clear();
+
+	//HEAD first, to find out if the server supports ranges and how large the resource is
+	probeReply = RequestBuilder(builder)
+			.setVerb("HEAD")
+			.send();
+	connect(probeReply, &QNetworkReply::finished,
+			this, &ParallelDownloadPrivate::probeFinished);
+}
+
+void ParallelDownloadPrivate::startSingle()
+{
+	ranged = false;
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+		fail(file.errorString(), file.error(), ParallelDownload::FileError);
+		return;
+	}
+
+	ranges.append(Range {0, total - 1, 0, nullptr});
+	nextRange = 0;
+	startNextRange();
+}
+
+void ParallelDownloadPrivate::startRanged()
+{
+	ranged = true;
+	if(!file.open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Unbuffered)) {
+		fail(file.errorString(), file.error(), ParallelDownload::FileError);
+		return;
+	}
+	//preallocate, so every range can be written at it's final position
+	if(!file.resize(total)) {
+		fail(file.errorString(), file.error(), ParallelDownload::FileError);
+		return;
+	}
+
+	auto rangeSize = qMax((total + parallelism - 1) / parallelism, minimumRangeSize);
+	for(qint64 begin = 0; begin < total; begin += rangeSize)
+		ranges.append(Range {begin, qMin(begin + rangeSize, total) - 1, begin, nullptr});
+
+	nextRange = 0;
+	while(activeRanges < parallelism && nextRange < ranges.size())
+		startNextRange();
+}
+
+void ParallelDownloadPrivate::startNextRange()
+{
+	auto &range = ranges[nextRange++];
+
+	RequestBuilder rangeBuilder(builder);
+	if(ranged) {
+		rangeBuilder.addHeader(RangeHeader, "bytes=" +
+							   QByteArray::number(range.begin) +
+							   '-' +
+							   QByteArray::number(range.end));
+		//if the resource changed in between, the server sends a 200 with the full content instead
+		if(!etag.isEmpty())
+			rangeBuilder.addHeader(IfRangeHeader, etag);
+	}
+
+	range.reply = rangeBuilder.send();
+	activeRanges++;
+	connect(range.reply, &QNetworkReply::readyRead,
+			this, &ParallelDownloadPrivate::rangeReadyRead);
+	connect(range.reply, &QNetworkReply::finished,
+			this, &ParallelDownloadPrivate::rangeFinished);
+}
+
+void ParallelDownloadPrivate::fail(const QString &errorString, int error, ParallelDownload::ErrorType errorType)
+{
+	cleanup();
+	if(file.isOpen())
+		file.close();
+	file.remove();
+	emit q->error(errorString, error, errorType, {});
+}
+
+void ParallelDownloadPrivate::cleanup()
+{
+	if(probeReply) {
+		probeReply->disconnect(this);
+		probeReply->abort();
+		probeReply->deleteLater();
+	}
+	for(auto &range : ranges) {
+		if(range.reply) {
+			range.reply->disconnect(this);
+			range.reply->abort();
+			range.reply->deleteLater();
+		}
+	}
+	ranges.clear();
+	activeRanges = 0;
+}
+
+void ParallelDownloadPrivate::probeFinished()
+{
+	auto reply = probeReply.data();
+	probeReply.clear();
+	reply->deleteLater();
+
+	if(reply->error() != QNetworkReply::NoError) {
+		//servers that do not implement HEAD still serve the resource with a plain GET
+		auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+		if(status == 405 || status == 501)
+			startSingle();
+		else
+			fail(reply->errorString(), reply->error());
+		return;
+	}
+
+	auto ok = false;
+	total = reply->header(QNetworkRequest::ContentLengthHeader).toLongLong(&ok);
+	if(!ok)
+		total = -1;
+	etag = reply->rawHeader(ETagHeader);
+	auto acceptsRanges = reply->rawHeader(AcceptRangesHeader)
+						 .split(',')
+						 .contains("bytes");
+
+	if(acceptsRanges &&
+	   total > minimumRangeSize &&
+	   parallelism > 1)
+		startRanged();
+	else
+		startSingle();
+}
+
+void ParallelDownloadPrivate::rangeReadyRead()
+{
+	auto reply = qobject_cast<QNetworkReply*>(sender());
+	auto index = rangeIndex(reply);
+	if(index < 0)
+		return;
+
+	//a full response would otherwise be buffered completely, as it is never read
+	auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	if(ranged && status != 206) {
+		if(reply->error() != QNetworkReply::NoError)
+			fail(reply->errorString(), reply->error());
+		else {
+			fail(ParallelDownload::tr("Resource changed or server ignored the range request (HTTP %1)").arg(status),
+				 QNetworkReply::ProtocolFailure);
+		}
+		return;
+	} else if(!ranged && status >= 300)//handled on finished
+		return;
+
+	auto &range = ranges[index];
+	auto data = reply->readAll();
+	if(ranged && range.pos + data.size() > range.end + 1) {
+		fail(ParallelDownload::tr("Server sent more data than requested for the range"),
+			 QNetworkReply::ProtocolFailure);
+		return;
+	}
+
+	if(!file.seek(range.pos) || file.write(data) != data.size()) {
+		fail(file.errorString(), file.error(), ParallelDownload::FileError);
+		return;
+	}
+	range.pos += data.size();
+	received += data.size();
+	emit q->downloadProgress(received, total);
+}
+
+void ParallelDownloadPrivate::rangeFinished()
+{
+	auto reply = qobject_cast<QNetworkReply*>(sender());
+	auto index = rangeIndex(reply);
+	if(index < 0)
+		return;
+	reply->deleteLater();
+
+	//write remaining data first
+	if(reply->bytesAvailable() > 0) {
+		rangeReadyRead();
+		if(rangeIndex(reply) < 0)//failed while writing
+			return;
+	}
+
+	auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	if(reply->error() != QNetworkReply::NoError) {
+		fail(reply->errorString(), reply->error());
+		return;
+	} else if(ranged && status != 206) {
+		fail(ParallelDownload::tr("Resource changed or server ignored the range request (HTTP %1)").arg(status),
+			 QNetworkReply::ProtocolFailure);
+		return;
+	}
+
+	auto &range = ranges[index];
+	if(range.end >= 0 && range.pos != range.end + 1) {
+		fail(ParallelDownload::tr("Range %1-%2 was incomplete").arg(range.begin).arg(range.end),
+			 QNetworkReply::ProtocolFailure);
+		return;
+	}
+	range.reply.clear();
+	activeRanges--;
+
+	if(nextRange < ranges.size())
+		startNextRange();
+	else if(activeRanges == 0) {
+		ranges.clear();
+		file.close();
+		if(total < 0)
+			total = received;
+		emit q->finished({});
+	}
+}
+
+int ParallelDownloadPrivate::rangeIndex(QNetworkReply *reply) const
+{
+	for(auto i = 0; i < ranges.size(); i++) {
+		if(ranges[i].reply == reply)
+			return i;
+	}
+	return -1;
+}
@@ -0,0 +1,84 @@
+#ifndef QTRESTCLIENT_PARALLELDOWNLOAD_H
+#define QTRESTCLIENT_PARALLELDOWNLOAD_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/requestbuilder.h"
+
+#include <QtCore/qobject.h>
+#include <QtNetwork/qnetworkreply.h>
+
+namespace QtRestClient {
+
+class ParallelDownloadPrivate;
+//! A class to download a single large resource in concurrent byte ranges
+class Q_RESTCLIENT_EXPORT ParallelDownload : public QObject
+{
+	Q_OBJECT
+	friend class ParallelDownloadPrivate;
+
+	//! The local file the resource is written to
+	Q_PROPERTY(QString filePath READ filePath CONSTANT)
+	//! The maximum number of ranges to be downloaded at the same time
+	Q_PROPERTY(int parallelism READ parallelism WRITE setParallelism NOTIFY parallelismChanged)
+	//! The minimum size of a single range, in bytes
+	Q_PROPERTY(qint64 minimumRangeSize READ minimumRangeSize WRITE setMinimumRangeSize NOTIFY minimumRangeSizeChanged)
+
+public:
+	//! Defines the different possible error types
+	enum ErrorType {
+		NetworkError,//!< The error code is a QNetworkReply::NetworkError
+		FileError//!< The error code is a QFileDevice::FileError
+	};
+	Q_ENUM(ErrorType)
+
+	//! Creates a new download for the resource the builder points to
+	ParallelDownload(const RequestBuilder &builder, const QString &filePath, QObject *parent = nullptr);
+	~ParallelDownload();
+
+	//! @readAcFn{ParallelDownload::filePath}
+	QString filePath() const;
+	//! @readAcFn{ParallelDownload::parallelism}
+	int parallelism() const;
+	//! @readAcFn{ParallelDownload::minimumRangeSize}
+	qint64 minimumRangeSize() const;
+
+	//! Returns true, if the server accepted byte ranges and the download is split
+	bool isRanged() const;
+	//! Returns true, if the download is currently running
+	bool isRunning() const;
+	//! Returns the number of bytes received so far
+	qint64 bytesReceived() const;
+	//! Returns the total size of the resource, or -1 if not known yet
+	qint64 bytesTotal() const;
+
+public Q_SLOTS:
+	//! Probes the resource and starts downloading it
+	void start();
+	//! Aborts all running requests and removes the partial file
+	void abort();
+
+	//! @writeAcFn{ParallelDownload::parallelism}
+	void setParallelism(int parallelism);
+	//! @writeAcFn{ParallelDownload::minimumRangeSize}
+	void setMinimumRangeSize(qint64 minimumRangeSize);
+
+Q_SIGNALS:
+	//! Is emitted when the complete resource has been written to the file
+	void finished(QPrivateSignal);
+	//! Is emitted if the download failed. The partial file has been removed
+	void error(const QString &errorString, int error, ErrorType errorType, QPrivateSignal);
+	//! Is emitted whenever data of any of the ranges was written to the file
+	void downloadProgress(qint64 bytesReceived, qint64 bytesTotal);
+
+	//! @notifyAcFn{ParallelDownload::parallelism}
+	void parallelismChanged(int parallelism, QPrivateSignal);
+	//! @notifyAcFn{ParallelDownload::minimumRangeSize}
+	void minimumRangeSizeChanged(qint64 minimumRangeSize, QPrivateSignal);
+
+private:
+	ParallelDownloadPrivate *d;
+};
+
+}
+
+#endif // QTRESTCLIENT_PARALLELDOWNLOAD_H
@@ -0,0 +1,65 @@
+#ifndef QTRESTCLIENT_PARALLELDOWNLOAD_P_H
+#define QTRESTCLIENT_PARALLELDOWNLOAD_P_H
+
+#include "paralleldownload.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QPointer>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT ParallelDownloadPrivate : public QObject
+{
+	Q_OBJECT
+
+public:
+	static const QByteArray AcceptRangesHeader;
+	static const QByteArray RangeHeader;
+	static const QByteArray IfRangeHeader;
+	static const QByteArray ETagHeader;
+
+	struct Range {
+		qint64 begin;
+		qint64 end;
+		qint64 pos;
+		QPointer<QNetworkReply> reply;
+	};
+
+	RequestBuilder builder;
+	QFile file;
+	int parallelism;
+	qint64 minimumRangeSize;
+
+	QPointer<QNetworkReply> probeReply;
+	QByteArray etag;
+	bool ranged;
+	qint64 received;
+	qint64 total;
+	QList<Range> ranges;
+	int nextRange;
+	int activeRanges;
+
+	ParallelDownloadPrivate(const RequestBuilder &builder, const QString &filePath, ParallelDownload *q_ptr);
+	~ParallelDownloadPrivate();
+
+	void startProbe();
+	void startSingle();
+	void startRanged();
+	void startNextRange();
+	void fail(const QString &errorString, int error, ParallelDownload::ErrorType errorType = ParallelDownload::NetworkError);
+	void cleanup();
+
+private Q_SLOTS:
+	void probeFinished();
+	void rangeReadyRead();
+	void rangeFinished();
+
+private:
+	ParallelDownload *q;
+
+	int rangeIndex(QNetworkReply *reply) const;
+};
+
+}
+
+#endif // QTRESTCLIENT_PARALLELDOWNLOAD_P_H
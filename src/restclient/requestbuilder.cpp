@@ -1,72 +1,15 @@
 #include "requestbuilder.h"
+#include "requestbuilder_p.h"
 #include "restreply_p.h"
+#include "requestinterceptor.h"
 
 #include <QtCore/QBuffer>
 #include <QtCore/QJsonDocument>
 using namespace QtRestClient;
 
-namespace QtRestClient {
-struct RequestBuilderPrivate : public QSharedData
-{
-	static QByteArray ContentType;
-	static QByteArray ContentTypeJson;
-
-	QNetworkAccessManager *nam;
-
-	QUrl base;
-	QVersionNumber version;
-	QString user;
-	QString pass;
-	QStringList path;
-	bool trailingSlash;
-	QUrlQuery query;
-	QString fragment;
-	HeaderHash headers;
-	QHash<QNetworkRequest::Attribute, QVariant> attributes;
-	QSslConfiguration sslConfig;
-	QByteArray body;
-	QByteArray verb;
-
-	inline RequestBuilderPrivate(QUrl baseUrl = QUrl(), QNetworkAccessManager *nam = nullptr) :
-		QSharedData(),
-		nam(nam),
-		base(baseUrl),
-		version(),
-		user(baseUrl.userName()),
-		pass(baseUrl.password()),
-		path(),
-		trailingSlash(false),
-		query(baseUrl.query()),
-		fragment(baseUrl.fragment()),
-		headers(),
-		attributes(),
-		sslConfig(QSslConfiguration::defaultConfiguration()),
-		body(),
-		verb("GET")
-	{}
-
-	inline RequestBuilderPrivate(const RequestBuilderPrivate &other) :
-		QSharedData(other),
-		nam(other.nam),
-		base(other.base),
-		version(other.version),
-		user(other.user),
-		pass(other.pass),
-		path(other.path),
-		trailingSlash(other.trailingSlash),
-		query(other.query),
-		fragment(other.fragment),
-		headers(other.headers),
-		attributes(other.attributes),
-		sslConfig(other.sslConfig),
-		body(other.body),
-		verb(other.verb)
-	{}
-};
-
 QByteArray RequestBuilderPrivate::ContentType = "Content-Type";
 QByteArray RequestBuilderPrivate::ContentTypeJson = "application/json";
-}
+QByteArray RequestBuilderPrivate::ContentDispositionFormData = "form-data; name=\"";
 
 RequestBuilder::RequestBuilder(const QUrl &baseUrl, QNetworkAccessManager *nam) :
 	d(new RequestBuilderPrivate(baseUrl, nam))
@@ -186,8 +129,18 @@ RequestBuilder &RequestBuilder::setSslConfig(const QSslConfiguration &sslConfig)
 	return *this;
 }
 
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+RequestBuilder &RequestBuilder::setHttp2Configuration(const QHttp2Configuration &http2Config)
+{
+	d->http2Config = http2Config;
+	d->hasHttp2Config = true;
+	return *this;
+}
+#endif
+
 RequestBuilder &RequestBuilder::setBody(const QByteArray &body, const QByteArray &contentType)
 {
+	d->clearBody();
 	d->body = body;
 	d->headers.insert(RequestBuilderPrivate::ContentType, contentType);
 	return *this;
@@ -195,6 +148,7 @@ RequestBuilder &RequestBuilder::setBody(const QByteArray &body, const QByteArray
 
 RequestBuilder &RequestBuilder::setBody(const QJsonObject &body)
 {
+	d->clearBody();
 	d->body = QJsonDocument(body).toJson(QJsonDocument::Compact);
 	d->headers.insert(RequestBuilderPrivate::ContentType, RequestBuilderPrivate::ContentTypeJson);
 	return *this;
@@ -202,17 +156,95 @@ RequestBuilder &RequestBuilder::setBody(const QJsonObject &body)
 
 RequestBuilder &RequestBuilder::setBody(const QJsonArray &body)
 {
+	d->clearBody();
 	d->body = QJsonDocument(body).toJson(QJsonDocument::Compact);
 	d->headers.insert(RequestBuilderPrivate::ContentType, RequestBuilderPrivate::ContentTypeJson);
 	return *this;
 }
 
+RequestBuilder &RequestBuilder::setBody(QIODevice *body, const QByteArray &contentType)
+{
+	d->clearBody();
+	d->bodyDevice = body;
+	d->headers.insert(RequestBuilderPrivate::ContentType, contentType);
+	return *this;
+}
+
+RequestBuilder &RequestBuilder::addPart(const QByteArray &name, const QByteArray &data, const QByteArray &contentType)
+{
+	QHttpPart part;
+	part.setHeader(QNetworkRequest::ContentDispositionHeader,
+				   RequestBuilderPrivate::ContentDispositionFormData + name + '"');
+	if(!contentType.isEmpty())
+		part.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
+	part.setBody(data);
+	return addPart(part);
+}
+
+RequestBuilder &RequestBuilder::addPart(const QByteArray &name, QIODevice *device, const QByteArray &contentType, const QString &fileName)
+{
+	auto disposition = RequestBuilderPrivate::ContentDispositionFormData + name + '"';
+	if(!fileName.isNull())
+		disposition += "; filename=\"" + fileName.toUtf8() + '"';
+
+	QHttpPart part;
+	part.setHeader(QNetworkRequest::ContentDispositionHeader, disposition);
+	if(!contentType.isEmpty())
+		part.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
+	part.setBodyDevice(device);
+	return addPart(part, device);
+}
+
+RequestBuilder &RequestBuilder::addPart(const QHttpPart &part, QIODevice *device)
+{
+	if(d->parts.isEmpty()) {
+		d->clearBody();
+		//the content type including the boundary is generated when sending
+		d->headers.remove(RequestBuilderPrivate::ContentType);
+	}
+	d->parts.append(part);
+	if(device)
+		d->partDevices.append(device);
+	return *this;
+}
+
+RequestBuilder &RequestBuilder::setMultiPartType(QHttpMultiPart::ContentType type)
+{
+	d->multiPartType = type;
+	return *this;
+}
+
 RequestBuilder &RequestBuilder::setVerb(const QByteArray &verb)
 {
 	d->verb = verb;
 	return *this;
 }
 
+QByteArray RequestBuilder::verb() const
+{
+	return d->verb;
+}
+
+HeaderHash RequestBuilder::headers() const
+{
+	return d->headers;
+}
+
+QByteArray RequestBuilder::body() const
+{
+	return d->body;
+}
+
+QIODevice *RequestBuilder::bodyDevice() const
+{
+	return d->bodyDevice.data();
+}
+
+bool RequestBuilder::hasMultiPartBody() const
+{
+	return !d->parts.isEmpty();
+}
+
 QUrl RequestBuilder::buildUrl() const
 {
 	auto url = d->base;
@@ -243,21 +275,62 @@ QNetworkRequest RequestBuilder::build() const
 	for(auto it = d->attributes.constBegin(); it != d->attributes.constEnd(); it++)
 		request.setAttribute(it.key(), it.value());
 	request.setSslConfiguration(d->sslConfig);
+	if(d->client)
+		request.setOriginatingObject(d->client.data());
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	if(d->hasHttp2Config)
+		request.setHttp2Configuration(d->http2Config);
+#endif
 	return request;
 }
 
 QNetworkReply *RequestBuilder::send() const
 {
-	auto request = build();
+	//the interceptors work on a copy, and may answer the request themselves
+	auto builder = *this;
+	const auto &bd = builder.d;
+	QList<QPointer<RequestInterceptor>> interceptors;
+	QNetworkReply *reply = nullptr;
+	if(d->client) {
+		for(auto interceptor : d->client->interceptors()) {
+			interceptors.append(interceptor);
+			reply = interceptor->interceptRequest(builder);
+			if(reply) {
+				reply->setProperty(RestReplyPrivate::PropertyVerb, bd->verb);
+				break;
+			}
+		}
+	}
 
-	QBuffer *buffer = nullptr;
-	if(!d->body.isEmpty()) {
-		buffer = new QBuffer();
-		buffer->setData(d->body);
-		buffer->open(QIODevice::ReadOnly);
+	if(!reply) {
+		auto request = builder.build();
+		if(!bd->parts.isEmpty()) {
+			auto multiPart = new MultiPartBody(bd->multiPartType, bd->parts, bd->partDevices);
+			reply = RestReplyPrivate::compatSend(bd->nam, request, bd->verb, multiPart);
+		} else {
+			QIODevice *buffer = nullptr;
+			if(bd->bodyDevice)
+				buffer = bd->bodyDevice.data();
+			else if(!bd->body.isEmpty()) {
+				auto byteBuffer = new QBuffer();
+				byteBuffer->setData(bd->body);
+				byteBuffer->open(QIODevice::ReadOnly);
+				buffer = byteBuffer;
+			}
+			reply = RestReplyPrivate::compatSend(bd->nam, request, bd->verb, buffer, !bd->bodyDevice);
+		}
 	}
 
-	return RestReplyPrivate::compatSend(d->nam, request, d->verb, buffer);
+	if(reply) {
+		for(auto it = bd->replyProperties.constBegin(); it != bd->replyProperties.constEnd(); it++)
+			reply->setProperty(it.key(), it.value());
+		//remember exactly who has seen the request, the chain may change until the reply finishes
+		if(!interceptors.isEmpty())
+			reply->setProperty(RestReplyPrivate::PropertyInterceptors, QVariant::fromValue(interceptors));
+		//retries are sent from the original builder, so the interceptors can run again
+		reply->setProperty(RestReplyPrivate::PropertyBuilder, QVariant::fromValue(QSharedPointer<RequestBuilder>::create(*this)));
+	}
+	return reply;
 }
 
 RequestBuilder &RequestBuilder::operator =(const RequestBuilder &other)
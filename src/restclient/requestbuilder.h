@@ -7,10 +7,14 @@
 #include <QtCore/qjsonobject.h>
 #include <QtNetwork/qnetworkreply.h>
 #include <QtNetwork/qnetworkrequest.h>
+#include <QtNetwork/qhttpmultipart.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qurlquery.h>
 #include <QtCore/qversionnumber.h>
 #include <QtCore/qshareddata.h>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+#include <QtNetwork/qhttp2configuration.h>
+#endif
 
 namespace QtRestClient {
 
@@ -18,6 +22,10 @@ struct RequestBuilderPrivate;
 //! A helper class to build QUrl and QNetworkRequest objects
 class Q_RESTCLIENT_EXPORT RequestBuilder
 {
+	friend class RestClient;
+	friend class RestClass;
+	friend class RestReplyPrivate;
+
 public:
 	//! Constructs a builder with the given base url
 	RequestBuilder(const QUrl &baseUrl, QNetworkAccessManager *nam = nullptr);
@@ -55,6 +63,10 @@ public:
 	RequestBuilder &setAttributes(const QHash<QNetworkRequest::Attribute, QVariant> &attributes);
 	//! Sets the ssl configuration to be used by the network request
 	RequestBuilder &setSslConfig(const QSslConfiguration &sslConfig);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	//! Sets the HTTP/2 configuration to be used by the network request
+	RequestBuilder &setHttp2Configuration(const QHttp2Configuration &http2Config);
+#endif
 
 	//! Sets the content of the generated network request
 	RequestBuilder &setBody(const QByteArray &body, const QByteArray &contentType);
@@ -62,9 +74,30 @@ public:
 	RequestBuilder &setBody(const QJsonObject &body);
 	//! @copydoc RequestBuilder::setBody(const QJsonObject &)
 	RequestBuilder &setBody(const QJsonArray &body);
+	//! Sets a device to be streamed as content of the generated network request
+	RequestBuilder &setBody(QIODevice *body, const QByteArray &contentType);
+	//! Adds a part with the given data to a multipart body
+	RequestBuilder &addPart(const QByteArray &name, const QByteArray &data, const QByteArray &contentType = QByteArray());
+	//! Adds a part that is streamed from the given device to a multipart body
+	RequestBuilder &addPart(const QByteArray &name, QIODevice *device, const QByteArray &contentType = QByteArray(), const QString &fileName = QString());
+	//! Adds a custom part to a multipart body
+	RequestBuilder &addPart(const QHttpPart &part, QIODevice *device = nullptr);
+	//! Sets the content type of a multipart body
+	RequestBuilder &setMultiPartType(QHttpMultiPart::ContentType type);
 	//! Sets the HTTP-Verb to be used by the generated network request
 	RequestBuilder &setVerb(const QByteArray &verb);
 
+	//! Returns the HTTP-Verb to be used by the generated network request
+	QByteArray verb() const;
+	//! Returns the HTTP headers to be added to the network request
+	HeaderHash headers() const;
+	//! Returns the content of the generated network request, if it was set as data
+	QByteArray body() const;
+	//! Returns the device to be streamed as content of the generated network request, if any
+	QIODevice *bodyDevice() const;
+	//! Returns true, if the content of the generated network request is a multipart body
+	bool hasMultiPartBody() const;
+
 	//! Creates a URL from the builder settings
 	QUrl buildUrl() const;
 	//! Creates a network request from the builder settings
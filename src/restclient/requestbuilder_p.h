@@ -0,0 +1,110 @@
+#ifndef QTRESTCLIENT_REQUESTBUILDER_P_H
+#define QTRESTCLIENT_REQUESTBUILDER_P_H
+
+#include "requestbuilder.h"
+#include "restclient.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+
+namespace QtRestClient {
+
+struct Q_RESTCLIENT_EXPORT RequestBuilderPrivate : public QSharedData
+{
+	static QByteArray ContentType;
+	static QByteArray ContentTypeJson;
+	static QByteArray ContentDispositionFormData;
+
+	QNetworkAccessManager *nam;
+	QPointer<RestClient> client;
+	QHash<QByteArray, QVariant> replyProperties;
+
+	QUrl base;
+	QVersionNumber version;
+	QString user;
+	QString pass;
+	QStringList path;
+	bool trailingSlash;
+	QUrlQuery query;
+	QString fragment;
+	HeaderHash headers;
+	QHash<QNetworkRequest::Attribute, QVariant> attributes;
+	QSslConfiguration sslConfig;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	QHttp2Configuration http2Config;
+	bool hasHttp2Config;
+#endif
+	QByteArray body;
+	QPointer<QIODevice> bodyDevice;
+	QList<QHttpPart> parts;
+	QList<QPointer<QIODevice>> partDevices;
+	QHttpMultiPart::ContentType multiPartType;
+	QByteArray verb;
+
+	inline RequestBuilderPrivate(QUrl baseUrl = QUrl(), QNetworkAccessManager *nam = nullptr) :
+		QSharedData(),
+		nam(nam),
+		client(),
+		replyProperties(),
+		base(baseUrl),
+		version(),
+		user(baseUrl.userName()),
+		pass(baseUrl.password()),
+		path(),
+		trailingSlash(false),
+		query(baseUrl.query()),
+		fragment(baseUrl.fragment()),
+		headers(),
+		attributes(),
+		sslConfig(QSslConfiguration::defaultConfiguration()),
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+		http2Config(),
+		hasHttp2Config(false),
+#endif
+		body(),
+		bodyDevice(),
+		parts(),
+		partDevices(),
+		multiPartType(QHttpMultiPart::FormDataType),
+		verb("GET")
+	{}
+
+	inline RequestBuilderPrivate(const RequestBuilderPrivate &other) :
+		QSharedData(other),
+		nam(other.nam),
+		client(other.client),
+		replyProperties(other.replyProperties),
+		base(other.base),
+		version(other.version),
+		user(other.user),
+		pass(other.pass),
+		path(other.path),
+		trailingSlash(other.trailingSlash),
+		query(other.query),
+		fragment(other.fragment),
+		headers(other.headers),
+		attributes(other.attributes),
+		sslConfig(other.sslConfig),
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+		http2Config(other.http2Config),
+		hasHttp2Config(other.hasHttp2Config),
+#endif
+		body(other.body),
+		bodyDevice(other.bodyDevice),
+		parts(other.parts),
+		partDevices(other.partDevices),
+		multiPartType(other.multiPartType),
+		verb(other.verb)
+	{}
+
+	inline void clearBody() {
+		body.clear();
+		bodyDevice.clear();
+		parts.clear();
+		partDevices.clear();
+	}
+};
+
+}
+
+#endif // QTRESTCLIENT_REQUESTBUILDER_P_H
@@ -0,0 +1,19 @@
+#include "requestinterceptor.h"
+using namespace QtRestClient;
+
+RequestInterceptor::RequestInterceptor(QObject *parent) :
+	QObject(parent)
+{}
+
+QNetworkReply *RequestInterceptor::interceptRequest(RequestBuilder &builder)
+{
+	Q_UNUSED(builder);
+	return nullptr;
+}
+
+void RequestInterceptor::interceptReply(QNetworkReply *reply, int &status, QByteArray &data)
+{
+	Q_UNUSED(reply);
+	Q_UNUSED(status);
+	Q_UNUSED(data);
+}
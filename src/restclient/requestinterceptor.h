@@ -0,0 +1,29 @@
+#ifndef QTRESTCLIENT_REQUESTINTERCEPTOR_H
+#define QTRESTCLIENT_REQUESTINTERCEPTOR_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/requestbuilder.h"
+
+#include <QtCore/qobject.h>
+#include <QtNetwork/qnetworkreply.h>
+
+namespace QtRestClient {
+
+//! An interface for middleware that can modify or answer the requests of a RestClient
+class Q_RESTCLIENT_EXPORT RequestInterceptor : public QObject
+{
+	Q_OBJECT
+
+public:
+	//! Constructor
+	explicit RequestInterceptor(QObject *parent = nullptr);
+
+	//! Is called for every request before it is sent. Return a reply to answer the request without sending it
+	virtual QNetworkReply *interceptRequest(RequestBuilder &builder);
+	//! Is called for every reply with the raw status and data, before they are parsed
+	virtual void interceptReply(QNetworkReply *reply, int &status, QByteArray &data);
+};
+
+}
+
+#endif // QTRESTCLIENT_REQUESTINTERCEPTOR_H
@@ -0,0 +1,140 @@
+#include "requestmetrics.h"
+#include "requestmetrics_p.h"
+using namespace QtRestClient;
+
+RequestMetrics::RequestMetrics() :
+	d(new RequestMetricsPrivate())
+{}
+
+RequestMetrics::RequestMetrics(const RequestMetrics &other) :
+	d(other.d)
+{}
+
+RequestMetrics::~RequestMetrics() {}
+
+QUrl RequestMetrics::url() const
+{
+	return d->url;
+}
+
+QByteArray RequestMetrics::verb() const
+{
+	return d->verb;
+}
+
+QString RequestMetrics::route() const
+{
+	return d->route;
+}
+
+int RequestMetrics::status() const
+{
+	return d->status;
+}
+
+int RequestMetrics::networkError() const
+{
+	return d->networkError;
+}
+
+TransportProfile::Protocol RequestMetrics::protocol() const
+{
+	return d->protocol;
+}
+
+qint64 RequestMetrics::bytesSent() const
+{
+	return d->bytesSent;
+}
+
+qint64 RequestMetrics::bytesReceived() const
+{
+	return d->bytesReceived;
+}
+
+int RequestMetrics::retryCount() const
+{
+	return d->retryCount;
+}
+
+bool RequestMetrics::fromCache() const
+{
+	return d->fromCache;
+}
+
+QByteArray RequestMetrics::traceParent() const
+{
+	return d->traceParent;
+}
+
+QByteArray RequestMetrics::parentSpanId() const
+{
+	return d->parentSpanId;
+}
+
+bool RequestMetrics::hasPhase(Phase phase) const
+{
+	return timestamp(phase) >= 0;
+}
+
+qint64 RequestMetrics::timestamp(Phase phase) const
+{
+	if(phase < 0 || phase >= RequestMetricsPrivate::PhaseCount)
+		return -1;
+	return d->timestamps[phase];
+}
+
+qint64 RequestMetrics::duration(Phase from, Phase to) const
+{
+	auto start = timestamp(from);
+	auto end = timestamp(to);
+	if(start < 0 || end < 0)
+		return -1;
+	return end - start;
+}
+
+RequestMetrics &RequestMetrics::operator=(const RequestMetrics &other)
+{
+	d = other.d;
+	return *this;
+}
+
+// ------------- Private Implementation -------------
+
+RequestMetricsPrivate::RequestMetricsPrivate() :
+	QSharedData(),
+	url(),
+	verb(),
+	route(),
+	status(0),
+	networkError(0),
+	protocol(TransportProfile::Http1),
+	bytesSent(0),
+	bytesReceived(0),
+	retryCount(0),
+	fromCache(false),
+	traceParent(),
+	parentSpanId()
+{
+	for(auto i = 0; i < PhaseCount; i++)
+		timestamps[i] = -1;
+}
+
+RequestMetricsPrivate::RequestMetricsPrivate(const RequestMetricsPrivate &other) :
+	QSharedData(other),
+	url(other.url),
+	verb(other.verb),
+	route(other.route),
+	status(other.status),
+	networkError(other.networkError),
+	protocol(other.protocol),
+	bytesSent(other.bytesSent),
+	bytesReceived(other.bytesReceived),
+	retryCount(other.retryCount),
+	fromCache(other.fromCache),
+	traceParent(other.traceParent),
+	parentSpanId(other.parentSpanId)
+{
+	for(auto i = 0; i < PhaseCount; i++)
+		timestamps[i] = other.timestamps[i];
+}
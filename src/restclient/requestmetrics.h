@@ -0,0 +1,108 @@
+#ifndef QTRESTCLIENT_REQUESTMETRICS_H
+#define QTRESTCLIENT_REQUESTMETRICS_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/transportprofile.h"
+
+#include <QtCore/qobject.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qurl.h>
+
+namespace QtRestClient {
+
+struct RequestMetricsPrivate;
+//! A timing record of a single request, from creation until all handlers have been called
+class Q_RESTCLIENT_EXPORT RequestMetrics
+{
+	Q_GADGET
+	friend class RestReplyPrivate;
+
+	//! The URL of the request
+	Q_PROPERTY(QUrl url READ url)
+	//! The HTTP verb of the request
+	Q_PROPERTY(QByteArray verb READ verb)
+	//! The path of the RestClass the request was sent by
+	Q_PROPERTY(QString route READ route)
+	//! The HTTP status code of the reply, or 0 if none was received
+	Q_PROPERTY(int status READ status)
+	//! The network error of the reply
+	Q_PROPERTY(int networkError READ networkError)
+	//! The HTTP protocol the reply was transferred with
+	Q_PROPERTY(QtRestClient::TransportProfile::Protocol protocol READ protocol)
+	//! The number of body bytes sent to the server
+	Q_PROPERTY(qint64 bytesSent READ bytesSent)
+	//! The number of body bytes received from the server
+	Q_PROPERTY(qint64 bytesReceived READ bytesReceived)
+	//! The number of times the request was retried before this attempt
+	Q_PROPERTY(int retryCount READ retryCount)
+	//! Specifies, whether the reply was loaded from a cache instead of the network
+	Q_PROPERTY(bool fromCache READ fromCache)
+	//! The W3C traceparent the request was sent with, if any
+	Q_PROPERTY(QByteArray traceParent READ traceParent)
+	//! The id of the span the request is a child of, if any
+	Q_PROPERTY(QByteArray parentSpanId READ parentSpanId)
+
+public:
+	//! The phases a request passes through
+	enum Phase {
+		Created,//!< The reply was created
+		Sent,//!< The request has been written to the connection
+		Encrypted,//!< The TLS handshake completed. Only reached for new HTTPS connections
+		FirstByte,//!< The reply headers were received
+		Finished,//!< The complete reply was received
+		Parsed,//!< The reply data was parsed to JSON
+		Deserialized,//!< The JSON was deserialized. **Generic replies only!**
+		HandlerDone//!< All result handlers have been called
+	};
+	Q_ENUM(Phase)
+
+	//! Constructor
+	RequestMetrics();
+	//! Copy Constructor
+	RequestMetrics(const RequestMetrics &other);
+	~RequestMetrics();
+
+	//! @readAcFn{RequestMetrics::url}
+	QUrl url() const;
+	//! @readAcFn{RequestMetrics::verb}
+	QByteArray verb() const;
+	//! @readAcFn{RequestMetrics::route}
+	QString route() const;
+	//! @readAcFn{RequestMetrics::status}
+	int status() const;
+	//! @readAcFn{RequestMetrics::networkError}
+	int networkError() const;
+	//! @readAcFn{RequestMetrics::protocol}
+	TransportProfile::Protocol protocol() const;
+	//! @readAcFn{RequestMetrics::bytesSent}
+	qint64 bytesSent() const;
+	//! @readAcFn{RequestMetrics::bytesReceived}
+	qint64 bytesReceived() const;
+	//! @readAcFn{RequestMetrics::retryCount}
+	int retryCount() const;
+	//! @readAcFn{RequestMetrics::fromCache}
+	bool fromCache() const;
+	//! @readAcFn{RequestMetrics::traceParent}
+	QByteArray traceParent() const;
+	//! @readAcFn{RequestMetrics::parentSpanId}
+	QByteArray parentSpanId() const;
+
+	//! Returns true, if the request has passed the given phase
+	bool hasPhase(Phase phase) const;
+	//! Returns the time the phase was reached at, in nanoseconds since RequestMetrics::Created
+	qint64 timestamp(Phase phase) const;
+	//! Returns the time between two phases in nanoseconds, or -1 if one of them was not reached
+	Q_INVOKABLE qint64 duration(Phase from, Phase to) const;
+
+	//! Assignment operator
+	RequestMetrics &operator=(const RequestMetrics &other);
+
+private:
+	QSharedDataPointer<RequestMetricsPrivate> d;
+};
+
+}
+
+Q_DECLARE_METATYPE(QtRestClient::RequestMetrics)
+
+#endif // QTRESTCLIENT_REQUESTMETRICS_H
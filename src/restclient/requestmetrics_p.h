@@ -0,0 +1,32 @@
+#ifndef QTRESTCLIENT_REQUESTMETRICS_P_H
+#define QTRESTCLIENT_REQUESTMETRICS_P_H
+
+#include "requestmetrics.h"
+
+namespace QtRestClient {
+
+struct Q_RESTCLIENT_EXPORT RequestMetricsPrivate : public QSharedData
+{
+	static const int PhaseCount = RequestMetrics::HandlerDone + 1;
+
+	QUrl url;
+	QByteArray verb;
+	QString route;
+	int status;
+	int networkError;
+	TransportProfile::Protocol protocol;
+	qint64 bytesSent;
+	qint64 bytesReceived;
+	int retryCount;
+	bool fromCache;
+	QByteArray traceParent;
+	QByteArray parentSpanId;
+	qint64 timestamps[PhaseCount];
+
+	RequestMetricsPrivate();
+	RequestMetricsPrivate(const RequestMetricsPrivate &other);
+};
+
+}
+
+#endif // QTRESTCLIENT_REQUESTMETRICS_P_H
@@ -0,0 +1,261 @@
+#include "requestsigner.h"
+#include "requestsigner_p.h"
+
+#include <QtCore/QMap>
+#include <QtCore/QMessageAuthenticationCode>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QUrlQuery>
+#include <algorithm>
+using namespace QtRestClient;
+
+const QByteArray RequestSigner::DateHeader("X-Amz-Date");
+const QByteArray RequestSigner::ContentHashHeader("X-Amz-Content-Sha256");
+const QByteArray RequestSigner::SecurityTokenHeader("X-Amz-Security-Token");
+const QByteArray RequestSigner::UnsignedPayload("UNSIGNED-PAYLOAD");
+
+RequestSigner::RequestSigner(QObject *parent) :
+	RequestInterceptor(parent),
+	d(new RequestSignerPrivate())
+{}
+
+RequestSigner::RequestSigner(const QString &accessKeyId, const QString &secretAccessKey, const QString &region, const QString &service, QObject *parent) :
+	RequestSigner(parent)
+{
+	d->accessKeyId = accessKeyId;
+	d->secretAccessKey = secretAccessKey.toUtf8();
+	d->region = region;
+	d->service = service;
+}
+
+RequestSigner::~RequestSigner() {}
+
+QString RequestSigner::accessKeyId() const
+{
+	QMutexLocker _(&d->keyMutex);
+	return d->accessKeyId;
+}
+
+QString RequestSigner::region() const
+{
+	return d->region;
+}
+
+QString RequestSigner::service() const
+{
+	return d->service;
+}
+
+bool RequestSigner::signPayload() const
+{
+	return d->signPayload;
+}
+
+void RequestSigner::sign(RequestBuilder &builder, const QDateTime &timestamp) const
+{
+	auto amzDate = timestamp.toUTC().toString(QStringLiteral("yyyyMMdd'T'HHmmss'Z'")).toLatin1();
+	auto date = amzDate.left(8);
+	auto region = d->region.toUtf8();
+	auto service = d->service.toUtf8();
+	auto payloadHash = d->payloadHash(builder);
+
+	//take all credentials at once, so a concurrent setCredentials can't mix two key pairs
+	QMutexLocker lock(&d->keyMutex);
+	auto accessKeyId = d->accessKeyId.toUtf8();
+	auto sessionToken = d->sessionToken.toUtf8();
+	auto signingKey = d->signingKey(date, region, service);
+	lock.unlock();
+
+	builder.addHeader(DateHeader, amzDate);
+	builder.addHeader(ContentHashHeader, payloadHash);
+	if(!sessionToken.isEmpty())
+		builder.addHeader(SecurityTokenHeader, sessionToken);
+
+	//canonical headers are sorted by their lowercase name
+	auto url = builder.buildUrl();
+	QMap<QByteArray, QByteArray> canonicalHeaders;
+	canonicalHeaders.insert("host", RequestSignerPrivate::hostOf(url));
+	auto headers = builder.headers();
+	for(auto it = headers.constBegin(); it != headers.constEnd(); it++) {
+		auto name = it.key().toLower();
+		if(name == "content-type" || name.startsWith("x-amz-"))
+			canonicalHeaders.insert(name, it.value().simplified());
+	}
+	QByteArray headerBlock;
+	QByteArrayList signedHeaderNames;
+	for(auto it = canonicalHeaders.constBegin(); it != canonicalHeaders.constEnd(); it++) {
+		headerBlock += it.key() + ':' + it.value() + '\n';
+		signedHeaderNames.append(it.key());
+	}
+	auto signedHeaders = signedHeaderNames.join(';');
+
+	auto canonicalRequest = builder.verb() + '\n' +
+							RequestSignerPrivate::canonicalPath(url) + '\n' +
+							RequestSignerPrivate::canonicalQuery(url) + '\n' +
+							headerBlock + '\n' +
+							signedHeaders + '\n' +
+							payloadHash;
+	auto scope = date + '/' + region + '/' + service + "/aws4_request";
+	auto stringToSign = RequestSignerPrivate::Algorithm + '\n' +
+						amzDate + '\n' +
+						scope + '\n' +
+						QCryptographicHash::hash(canonicalRequest, QCryptographicHash::Sha256).toHex();
+	auto signature = QMessageAuthenticationCode::hash(stringToSign,
+													  signingKey,
+													  QCryptographicHash::Sha256).toHex();
+
+	builder.addHeader("Authorization",
+					  RequestSignerPrivate::Algorithm +
+					  " Credential=" + accessKeyId + '/' + scope +
+					  ", SignedHeaders=" + signedHeaders +
+					  ", Signature=" + signature);
+}
+
+QNetworkReply *RequestSigner::interceptRequest(RequestBuilder &builder)
+{
+	sign(builder, QDateTime::currentDateTimeUtc());
+	return nullptr;
+}
+
+void RequestSigner::setCredentials(const QString &accessKeyId, const QString &secretAccessKey, const QString &sessionToken)
+{
+	QMutexLocker _(&d->keyMutex);
+	d->accessKeyId = accessKeyId;
+	d->secretAccessKey = secretAccessKey.toUtf8();
+	d->sessionToken = sessionToken;
+	d->signingKeys.clear();
+	_.unlock();
+	emit credentialsChanged(accessKeyId, {});
+}
+
+void RequestSigner::setRegion(QString region)
+{
+	if (d->region == region)
+		return;
+
+	d->region = region;
+	emit regionChanged(region, {});
+}
+
+void RequestSigner::setService(QString service)
+{
+	if (d->service == service)
+		return;
+
+	d->service = service;
+	emit serviceChanged(service, {});
+}
+
+void RequestSigner::setSignPayload(bool signPayload)
+{
+	if (d->signPayload == signPayload)
+		return;
+
+	d->signPayload = signPayload;
+	emit signPayloadChanged(signPayload, {});
+}
+
+// ------------- Private Implementation -------------
+
+const QByteArray RequestSignerPrivate::Algorithm("AWS4-HMAC-SHA256");
+const qint64 RequestSignerPrivate::HashChunkSize = 64 * 1024;
+
+RequestSignerPrivate::RequestSignerPrivate() :
+	accessKeyId(),
+	secretAccessKey(),
+	sessionToken(),
+	region(),
+	service(),
+	signPayload(true),
+	keyMutex(),
+	keyDate(),
+	signingKeys()
+{}
+
+QByteArray RequestSignerPrivate::signingKey(const QByteArray &date, const QByteArray &region, const QByteArray &service) const
+{
+	//the derived keys only change once a day, so only the current day is cached
+	//the caller must hold keyMutex
+	if(keyDate != date) {
+		signingKeys.clear();
+		keyDate = date;
+	}
+	auto scope = region + '/' + service;
+	auto it = signingKeys.constFind(scope);
+	if(it != signingKeys.constEnd())
+		return *it;
+
+	auto key = QMessageAuthenticationCode::hash(date, "AWS4" + secretAccessKey, QCryptographicHash::Sha256);
+	key = QMessageAuthenticationCode::hash(region, key, QCryptographicHash::Sha256);
+	key = QMessageAuthenticationCode::hash(service, key, QCryptographicHash::Sha256);
+	key = QMessageAuthenticationCode::hash("aws4_request", key, QCryptographicHash::Sha256);
+	signingKeys.insert(scope, key);
+	return key;
+}
+
+QByteArray RequestSignerPrivate::payloadHash(const RequestBuilder &builder) const
+{
+	//multipart boundaries are only generated when sending
+	if(!signPayload || builder.hasMultiPartBody())
+		return RequestSigner::UnsignedPayload;
+	auto device = builder.bodyDevice();
+	if(device) {
+		auto hash = hashDevice(device);
+		return hash.isNull() ? RequestSigner::UnsignedPayload : hash;
+	} else
+		return QCryptographicHash::hash(builder.body(), QCryptographicHash::Sha256).toHex();
+}
+
+QByteArray RequestSignerPrivate::hashDevice(QIODevice *device)
+{
+	//streams can't be read twice, so they can't be signed
+	if(!device->isReadable() || device->isSequential())
+		return QByteArray();
+
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+	QByteArray buffer(static_cast<int>(HashChunkSize), Qt::Uninitialized);
+	auto startPos = device->pos();
+	qint64 read;
+	while((read = device->read(buffer.data(), buffer.size())) > 0)
+		hash.addData(buffer.constData(), static_cast<int>(read));
+	if(read < 0 || !device->seek(startPos))
+		return QByteArray();
+	return hash.result().toHex();
+}
+
+QByteArray RequestSignerPrivate::canonicalPath(const QUrl &url)
+{
+	auto segments = url.path(QUrl::FullyDecoded).split(QLatin1Char('/'));
+	QByteArrayList encoded;
+	encoded.reserve(segments.size());
+	for(auto segment : segments)
+		encoded.append(QUrl::toPercentEncoding(segment));
+	auto path = encoded.join('/');
+	return path.isEmpty() ? QByteArray("/") : path;
+}
+
+QByteArray RequestSignerPrivate::canonicalQuery(const QUrl &url)
+{
+	//sorted by name first, then by value
+	QList<QPair<QByteArray, QByteArray>> parameters;
+	for(auto item : QUrlQuery(url).queryItems(QUrl::FullyDecoded))
+		parameters.append({QUrl::toPercentEncoding(item.first), QUrl::toPercentEncoding(item.second)});
+	std::sort(parameters.begin(), parameters.end());
+
+	QByteArrayList encoded;
+	encoded.reserve(parameters.size());
+	for(auto parameter : parameters)
+		encoded.append(parameter.first + '=' + parameter.second);
+	return encoded.join('&');
+}
+
+QByteArray RequestSignerPrivate::hostOf(const QUrl &url)
+{
+	auto host = url.host(QUrl::FullyEncoded).toUtf8();
+	auto port = url.port();
+	auto scheme = url.scheme();
+	if(port != -1 &&
+	   !(port == 80 && scheme == QStringLiteral("http")) &&
+	   !(port == 443 && scheme == QStringLiteral("https")))
+		host += ':' + QByteArray::number(port);
+	return host;
+}
@@ -0,0 +1,90 @@
+#ifndef QTRESTCLIENT_REQUESTSIGNER_H
+#define QTRESTCLIENT_REQUESTSIGNER_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/requestinterceptor.h"
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qscopedpointer.h>
+
+namespace QtRestClient {
+
+class RequestSignerPrivate;
+//! An interceptor that signs requests with HMAC-SHA256, following the AWS Signature Version 4 scheme
+class Q_RESTCLIENT_EXPORT RequestSigner : public RequestInterceptor
+{
+	Q_OBJECT
+	friend class RequestSignerPrivate;
+
+	//! The id of the access key requests are signed with
+	Q_PROPERTY(QString accessKeyId READ accessKeyId NOTIFY credentialsChanged)
+	//! The region that is part of the credential scope
+	Q_PROPERTY(QString region READ region WRITE setRegion NOTIFY regionChanged)
+	//! The service that is part of the credential scope
+	Q_PROPERTY(QString service READ service WRITE setService NOTIFY serviceChanged)
+	//! Specifies, whether the request body is included in the signature
+	Q_PROPERTY(bool signPayload READ signPayload WRITE setSignPayload NOTIFY signPayloadChanged)
+
+public:
+	//! The name of the date header
+	static const QByteArray DateHeader;
+	//! The name of the payload hash header
+	static const QByteArray ContentHashHeader;
+	//! The name of the session token header
+	static const QByteArray SecurityTokenHeader;
+	//! The payload hash of requests with a body that is not signed
+	static const QByteArray UnsignedPayload;
+
+	//! Constructor
+	explicit RequestSigner(QObject *parent = nullptr);
+	//! Constructor, with credentials and scope
+	RequestSigner(const QString &accessKeyId,
+				  const QString &secretAccessKey,
+				  const QString &region,
+				  const QString &service,
+				  QObject *parent = nullptr);
+	~RequestSigner();
+
+	//! @readAcFn{RequestSigner::accessKeyId}
+	QString accessKeyId() const;
+	//! @readAcFn{RequestSigner::region}
+	QString region() const;
+	//! @readAcFn{RequestSigner::service}
+	QString service() const;
+	//! @readAcFn{RequestSigner::signPayload}
+	bool signPayload() const;
+
+	//! Signs the builder for the given time, by adding the date, payload hash and Authorization headers
+	void sign(RequestBuilder &builder, const QDateTime &timestamp) const;
+
+	//! @inherit{RequestInterceptor::interceptRequest}
+	QNetworkReply *interceptRequest(RequestBuilder &builder) override;
+
+public Q_SLOTS:
+	//! Sets the credentials requests are signed with. The session token is optional
+	void setCredentials(const QString &accessKeyId, const QString &secretAccessKey, const QString &sessionToken = QString());
+
+	//! @writeAcFn{RequestSigner::region}
+	void setRegion(QString region);
+	//! @writeAcFn{RequestSigner::service}
+	void setService(QString service);
+	//! @writeAcFn{RequestSigner::signPayload}
+	void setSignPayload(bool signPayload);
+
+Q_SIGNALS:
+	//! @notifyAcFn{RequestSigner::accessKeyId}
+	void credentialsChanged(QString accessKeyId, QPrivateSignal);
+	//! @notifyAcFn{RequestSigner::region}
+	void regionChanged(QString region, QPrivateSignal);
+	//! @notifyAcFn{RequestSigner::service}
+	void serviceChanged(QString service, QPrivateSignal);
+	//! @notifyAcFn{RequestSigner::signPayload}
+	void signPayloadChanged(bool signPayload, QPrivateSignal);
+
+private:
+	QScopedPointer<RequestSignerPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_REQUESTSIGNER_H
@@ -0,0 +1,43 @@
+#ifndef QTRESTCLIENT_REQUESTSIGNER_P_H
+#define QTRESTCLIENT_REQUESTSIGNER_P_H
+
+#include "requestsigner.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QMutex>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT RequestSignerPrivate
+{
+	friend class RequestSigner;
+
+public:
+	static const QByteArray Algorithm;
+	static const qint64 HashChunkSize;
+
+	QString accessKeyId;
+	QByteArray secretAccessKey;
+	QString sessionToken;
+	QString region;
+	QString service;
+	bool signPayload;
+
+	mutable QMutex keyMutex;
+	mutable QByteArray keyDate;
+	mutable QHash<QByteArray, QByteArray> signingKeys;
+
+	RequestSignerPrivate();
+
+	QByteArray signingKey(const QByteArray &date, const QByteArray &region, const QByteArray &service) const;
+	QByteArray payloadHash(const RequestBuilder &builder) const;
+
+	static QByteArray hashDevice(QIODevice *device);
+	static QByteArray canonicalPath(const QUrl &url);
+	static QByteArray canonicalQuery(const QUrl &url);
+	static QByteArray hostOf(const QUrl &url);
+};
+
+}
+
+#endif // QTRESTCLIENT_REQUESTSIGNER_P_H
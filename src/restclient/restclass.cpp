@@ -1,5 +1,7 @@
 #include "restclass.h"
 #include "restclass_p.h"
+#include "requestbuilder_p.h"
+#include "restreply_p.h"
 #include "restclient.h"
 using namespace QtRestClient;
 
@@ -76,10 +78,33 @@ RestReply *RestClass::callJson(QByteArray verb, const QUrl &relativeUrl, QJsonAr
 	return new RestReply(create(verb, relativeUrl, body, parameters, headers), this);
 }
 
+Result<QJsonValue> RestClass::callJsonSync(QByteArray verb, const QString &methodPath, const QVariantHash &parameters, const HeaderHash &headers)
+{
+	return runSync<QJsonValue>([=](){
+		return callJson(verb, methodPath, parameters, headers)->toFuture();
+	});
+}
+
+Result<QJsonValue> RestClass::callJsonSync(QByteArray verb, const QString &methodPath, QJsonObject body, const QVariantHash &parameters, const HeaderHash &headers)
+{
+	return runSync<QJsonValue>([=](){
+		return callJson(verb, methodPath, body, parameters, headers)->toFuture();
+	});
+}
+
+Result<QJsonValue> RestClass::callJsonSync(QByteArray verb, const QString &methodPath, QJsonArray body, const QVariantHash &parameters, const HeaderHash &headers)
+{
+	return runSync<QJsonValue>([=](){
+		return callJson(verb, methodPath, body, parameters, headers)->toFuture();
+	});
+}
+
 RequestBuilder RestClass::builder() const
 {
-	return d->client->builder()
-			.addPath(d->subPath);
+	auto builder = d->client->builder()
+				   .addPath(d->subPath);
+	builder.d->replyProperties.insert(RestReplyPrivate::PropertyRoute, d->subPath.join(QLatin1Char('/')));
+	return builder;
 }
 
 QNetworkReply *RestClass::create(QByteArray verb, const QString &methodPath, const QVariantHash &parameters, const HeaderHash &headers)
@@ -175,6 +200,20 @@ QNetworkReply *RestClass::create(QByteArray verb, const QUrl &relativeUrl, QJson
 			.send();
 }
 
+RestReplyException RestClass::syncThreadError()
+{
+	return RestReplyException(QStringLiteral("Synchronous requests cannot be sent from the thread of the RestClass"),
+							  QNetworkReply::OperationNotImplementedError,
+							  RestReply::NetworkError);
+}
+
+RestReplyException RestClass::syncTimeoutError()
+{
+	return RestReplyException(QStringLiteral("The synchronous request did not complete within the syncTimeout"),
+							  QNetworkReply::TimeoutError,
+							  RestReply::NetworkError);
+}
+
 // ------------- Private Implementation -------------
 
 QUrlQuery RestClassPrivate::hashToQuery(const QVariantHash &hash)
@@ -6,11 +6,41 @@
 #include "QtRestClient/restreply.h"
 #include "QtRestClient/genericrestreply.h"
 #include "QtRestClient/restclient.h"
+#include "QtRestClient/result.h"
 
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfuturewatcher.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qobject.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
 
 namespace QtRestClient {
 
+namespace Private {
+
+//! @private
+class Q_RESTCLIENT_EXPORT SyncTrigger : public QObject
+{
+	Q_OBJECT
+
+Q_SIGNALS:
+	void triggered();
+};
+
+template <typename T>
+struct SyncState
+{
+	QMutex mutex;
+	QWaitCondition condition;
+	QFuture<T> future;
+	bool finished = false;
+	bool abandoned = false;
+};
+
+}
+
 class RestClassPrivate;
 //! A class to perform requests to an API
 class Q_RESTCLIENT_EXPORT RestClass : public QObject
@@ -224,6 +254,34 @@ public:
 	}
 	//! @}
 
+	//synchronous calls, for threads other than the one of the class
+	//! @{
+	//! @brief Performs a API call and blocks the calling thread until the reply completed
+	Result<QJsonValue> callJsonSync(QByteArray verb, const QString &methodPath, const QVariantHash &parameters = {}, const HeaderHash &headers = {});
+	Result<QJsonValue> callJsonSync(QByteArray verb, const QString &methodPath, QJsonObject body, const QVariantHash &parameters = {}, const HeaderHash &headers = {});
+	Result<QJsonValue> callJsonSync(QByteArray verb, const QString &methodPath, QJsonArray body, const QVariantHash &parameters = {}, const HeaderHash &headers = {});
+	template<typename DT = QObject*, typename ET = QObject*>
+	Result<DT> callSync(QByteArray verb, const QString &methodPath, const QVariantHash &parameters = {}, const HeaderHash &headers = {});
+	template<typename DT = QObject*, typename ET = QObject*, typename RO = QObject*>
+	Result<DT> callSync(QByteArray verb, const QString &methodPath, RO body, const QVariantHash &parameters = {}, const HeaderHash &headers = {});
+	template<typename DT = QObject*, typename ET = QObject*>
+	Result<DT> getSync(const QString &methodPath, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) {
+		return callSync<DT, ET>(GetVerb, methodPath, parameters, headers);
+	}
+	template<typename DT = QObject*, typename ET = QObject*, typename RO = QObject*>
+	Result<DT> postSync(const QString &methodPath, RO body, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) {
+		return callSync<DT, ET>(PostVerb, methodPath, body, parameters, headers);
+	}
+	template<typename DT = QObject*, typename ET = QObject*, typename RO = QObject*>
+	Result<DT> putSync(const QString &methodPath, RO body, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) {
+		return callSync<DT, ET>(PutVerb, methodPath, body, parameters, headers);
+	}
+	template<typename DT = QObject*, typename ET = QObject*>
+	Result<DT> deleteResourceSync(const QString &methodPath, const QVariantHash &parameters = {}, const HeaderHash &headers = {}) {
+		return callSync<DT, ET>(DeleteVerb, methodPath, parameters, headers);
+	}
+	//! @}
+
 	//! Creates a request builder for this class
 	virtual RequestBuilder builder() const;
 
@@ -248,6 +306,11 @@ private:
 	QNetworkReply *create(QByteArray verb, const QUrl &relativeUrl, const QVariantHash &parameters, const HeaderHash &headers);
 	QNetworkReply *create(QByteArray verb, const QUrl &relativeUrl, QJsonObject body, const QVariantHash &parameters, const HeaderHash &headers);
 	QNetworkReply *create(QByteArray verb, const QUrl &relativeUrl, QJsonArray body, const QVariantHash &parameters, const HeaderHash &headers);
+
+	template<typename T>
+	Result<T> runSync(const std::function<QFuture<T>()> &start);
+	static RestReplyException syncThreadError();
+	static RestReplyException syncTimeoutError();
 };
 
 //! Short macro for RestClass::concatParams(), to make the call shorter
@@ -363,6 +426,70 @@ GenericRestReply<DT, ET> *RestClass::call(QByteArray verb, const QUrl &relativeU
 										this);
 }
 
+template<typename DT, typename ET>
+Result<DT> RestClass::callSync(QByteArray verb, const QString &methodPath, const QVariantHash &parameters, const HeaderHash &headers)
+{
+	return runSync<DT>([=](){
+		return call<DT, ET>(verb, methodPath, parameters, headers)->toFuture();
+	});
+}
+
+template<typename DT, typename ET, typename RO>
+Result<DT> RestClass::callSync(QByteArray verb, const QString &methodPath, RO body, const QVariantHash &parameters, const HeaderHash &headers)
+{
+	return runSync<DT>([=](){
+		return call<DT, ET>(verb, methodPath, body, parameters, headers)->toFuture();
+	});
+}
+
+template<typename T>
+Result<T> RestClass::runSync(const std::function<QFuture<T>()> &start)
+{
+	if(QThread::currentThread() == thread())
+		return syncThreadError();
+
+	//started by the event loop of the class thread, the caller may give up and leave
+	auto state = QSharedPointer<Private::SyncState<T>>::create();
+	Private::SyncTrigger trigger;
+	connect(&trigger, &Private::SyncTrigger::triggered, this, [state, start](){
+		QMutexLocker _(&state->mutex);
+		if(state->abandoned)
+			return;
+		state->future = start();
+		auto watcher = new QFutureWatcher<T>();
+		connect(watcher, &QFutureWatcherBase::finished, watcher, [state, watcher](){
+			QMutexLocker _(&state->mutex);
+			state->finished = true;
+			state->condition.wakeAll();
+			watcher->deleteLater();
+		});
+		watcher->setFuture(state->future);
+	}, Qt::QueuedConnection);
+	emit trigger.triggered();
+
+	auto timeout = client()->syncTimeout();
+	QElapsedTimer timer;
+	timer.start();
+	QMutexLocker lock(&state->mutex);
+	while(!state->finished) {
+		if(timeout == 0)
+			state->condition.wait(&state->mutex);
+		else {
+			auto remaining = timeout - timer.elapsed();
+			if(remaining <= 0 ||
+			   (!state->condition.wait(&state->mutex, static_cast<unsigned long>(remaining)) && !state->finished)) {
+				//aborts the reply, if it has been started
+				state->abandoned = true;
+				state->future.cancel();
+				return syncTimeoutError();
+			}
+		}
+	}
+	auto future = state->future;
+	lock.unlock();
+	return Result<T>::fromFuture(future);
+}
+
 template<typename... Args>
 QVariantHash RestClass::concatParams(QString key, QVariant value, Args... parameters)
 {
@@ -1,7 +1,12 @@
 #include "restclient.h"
 #include "restclient_p.h"
 #include "restclass.h"
+#include "paralleldownload.h"
+#include "tlssessioncache.h"
 #include "standardpaging_p.h"
+#include "requestbuilder_p.h"
+#include "metricssnapshot_p.h"
+#include "restreply_p.h"
 #include <QtCore/QBitArray>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QRegularExpression>
@@ -16,6 +21,7 @@ RestClient::RestClient(QObject *parent) :
 #if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
 	d->nam->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
 #endif
+	d->connectManager();
 }
 
 RestClient::~RestClient() {}
@@ -45,6 +51,32 @@ PagingFactory *RestClient::pagingFactory() const
 	return d->pagingFactory.data();
 }
 
+TlsSessionCache *RestClient::tlsSessionCache() const
+{
+	return d->tlsSessionCache;
+}
+
+PageCache *RestClient::pageCache() const
+{
+	return d->pageCache;
+}
+
+Tracer *RestClient::tracer() const
+{
+	return d->tracer;
+}
+
+QList<RequestInterceptor*> RestClient::interceptors() const
+{
+	QList<RequestInterceptor*> interceptors;
+	interceptors.reserve(d->interceptors.size());
+	for(auto interceptor : d->interceptors) {
+		if(interceptor)
+			interceptors.append(interceptor);
+	}
+	return interceptors;
+}
+
 QUrl RestClient::baseUrl() const
 {
 	return d->baseUrl;
@@ -75,14 +107,70 @@ QSslConfiguration RestClient::sslConfiguration() const
 	return d->sslConfig;
 }
 
+bool RestClient::autoWarmUp() const
+{
+	return d->autoWarmUp;
+}
+
+TransportProfile RestClient::transportProfile() const
+{
+	return d->transportProfile;
+}
+
+bool RestClient::pagingPrefetch() const
+{
+	return d->pagingPrefetch;
+}
+
+bool RestClient::pagingOwnsItems() const
+{
+	return d->pagingOwnsItems;
+}
+
+int RestClient::syncTimeout() const
+{
+	//read by the threads waiting for synchronous calls
+	return d->syncTimeout.load();
+}
+
 RequestBuilder RestClient::builder() const
 {
-	return RequestBuilder(d->baseUrl, d->nam)
-			.setVersion(d->apiVersion)
-			.addHeaders(d->headers)
-			.addParameters(d->query)
-			.setAttributes(d->attribs)
-			.setSslConfig(d->sslConfig);
+	auto builder = RequestBuilder(d->baseUrl, d->nam)
+				   .setVersion(d->apiVersion)
+				   .addHeaders(d->headers)
+				   .addParameters(d->query)
+				   .setAttributes(d->effectiveAttributes())
+				   .setSslConfig(d->sslConfigFor(d->baseUrl));
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	if(d->hasTransportProfile)
+		builder.setHttp2Configuration(d->transportProfile.http2Configuration());
+#endif
+	//allows replies to find the client they were sent by
+	builder.d->client = const_cast<RestClient*>(this);
+	if(d->tracer) {
+		auto parentContext = d->tracer->parentContext();
+		builder.addHeader(Tracer::TraceParentHeader, d->tracer->createTraceParent());
+		if(!d->tracer->traceState().isEmpty())
+			builder.addHeader(Tracer::TraceStateHeader, d->tracer->traceState());
+		if(!parentContext.isEmpty())
+			builder.d->replyProperties.insert(RestReplyPrivate::PropertyParentSpan, parentContext.split('-').value(2));
+	}
+	return builder;
+}
+
+MetricsSnapshot RestClient::metricsSnapshot() const
+{
+	return d->metrics;
+}
+
+ParallelDownload *RestClient::download(const QUrl &relativeUrl, const QString &filePath, int parallelism)
+{
+	auto download = new ParallelDownload(builder().updateFromRelativeUrl(relativeUrl, true),
+										 filePath,
+										 this);
+	download->setParallelism(parallelism);
+	download->start();
+	return download;
 }
 
 void RestClient::setManager(QNetworkAccessManager *manager)
@@ -90,6 +178,7 @@ void RestClient::setManager(QNetworkAccessManager *manager)
 	d->nam->deleteLater();
 	d->nam = manager;
 	manager->setParent(this);
+	d->connectManager();
 }
 
 void RestClient::setSerializer(QJsonSerializer *serializer)
@@ -104,6 +193,50 @@ void RestClient::setPagingFactory(PagingFactory *factory)
 	d->pagingFactory.reset(factory);
 }
 
+void RestClient::setTlsSessionCache(TlsSessionCache *cache)
+{
+	d->tlsSessionCache = cache;
+}
+
+void RestClient::setPageCache(PageCache *cache)
+{
+	d->pageCache = cache;
+}
+
+void RestClient::setTracer(Tracer *tracer)
+{
+	if(d->tracer)
+		disconnect(this, &RestClient::requestCompleted, d->tracer, &Tracer::recordRequest);
+	d->tracer = tracer;
+	if(d->tracer)
+		connect(this, &RestClient::requestCompleted, d->tracer, &Tracer::recordRequest);
+}
+
+void RestClient::addInterceptor(RequestInterceptor *interceptor)
+{
+	insertInterceptor(d->interceptors.size(), interceptor);
+}
+
+void RestClient::insertInterceptor(int index, RequestInterceptor *interceptor)
+{
+	if(!interceptor)
+		return;
+	d->interceptors.removeAll(nullptr);
+	d->interceptors.removeAll(interceptor);
+	d->interceptors.insert(qBound(0, index, d->interceptors.size()), interceptor);
+	if(!interceptor->parent())
+		interceptor->setParent(this);
+}
+
+void RestClient::removeInterceptor(RequestInterceptor *interceptor)
+{
+	if(!interceptor)
+		return;
+	d->interceptors.removeAll(interceptor);
+	if(interceptor->parent() == this)
+		interceptor->setParent(nullptr);
+}
+
 void RestClient::setBaseUrl(QUrl baseUrl)
 {
 	if (d->baseUrl == baseUrl)
@@ -111,6 +244,8 @@ void RestClient::setBaseUrl(QUrl baseUrl)
 
 	d->baseUrl = baseUrl;
 	emit baseUrlChanged(baseUrl, {});
+	if(d->autoWarmUp)
+		warmUp();
 }
 
 void RestClient::setApiVersion(QVersionNumber apiVersion)
@@ -169,6 +304,75 @@ void RestClient::setSslConfiguration(QSslConfiguration sslConfiguration)
 	emit sslConfigurationChanged(sslConfiguration, {});
 }
 
+void RestClient::setAutoWarmUp(bool autoWarmUp)
+{
+	if (d->autoWarmUp == autoWarmUp)
+		return;
+
+	d->autoWarmUp = autoWarmUp;
+	emit autoWarmUpChanged(autoWarmUp, {});
+}
+
+void RestClient::setTransportProfile(TransportProfile transportProfile)
+{
+	d->hasTransportProfile = true;
+	if (d->transportProfile == transportProfile)
+		return;
+
+	d->transportProfile = transportProfile;
+	emit transportProfileChanged(transportProfile, {});
+}
+
+void RestClient::setPagingPrefetch(bool pagingPrefetch)
+{
+	if (d->pagingPrefetch == pagingPrefetch)
+		return;
+
+	d->pagingPrefetch = pagingPrefetch;
+	emit pagingPrefetchChanged(pagingPrefetch, {});
+}
+
+void RestClient::setPagingOwnsItems(bool pagingOwnsItems)
+{
+	if (d->pagingOwnsItems == pagingOwnsItems)
+		return;
+
+	d->pagingOwnsItems = pagingOwnsItems;
+	emit pagingOwnsItemsChanged(pagingOwnsItems, {});
+}
+
+void RestClient::setSyncTimeout(int syncTimeout)
+{
+	syncTimeout = qMax(0, syncTimeout);
+	if (d->syncTimeout.load() == syncTimeout)
+		return;
+
+	d->syncTimeout.store(syncTimeout);
+	emit syncTimeoutChanged(syncTimeout, {});
+}
+
+void RestClient::warmUp()
+{
+	auto host = d->baseUrl.host();
+	if(host.isEmpty())
+		return;
+
+	if(d->baseUrl.scheme() == QStringLiteral("https")) {
+		auto config = d->sslConfigFor(d->baseUrl);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+		//negotiate the same protocol the requests will use, so the connection can be reused
+		if(d->effectiveAttributes().value(QNetworkRequest::HTTP2AllowedAttribute, false).toBool()) {
+			config.setAllowedNextProtocols({
+											   QSslConfiguration::ALPNProtocolHTTP2,
+											   QSslConfiguration::NextProtocolHttp1_1
+										   });
+		}
+#endif
+		d->nam->connectToHostEncrypted(host, static_cast<quint16>(d->baseUrl.port(443)), config);
+	} else if(d->baseUrl.scheme() == QStringLiteral("http"))
+		d->nam->connectToHost(host, static_cast<quint16>(d->baseUrl.port(80)));
+}
+
 void RestClient::addGlobalHeader(QByteArray name, QByteArray value)
 {
 	d->headers.insert(name, value);
@@ -216,12 +420,72 @@ RestClientPrivate::RestClientPrivate(RestClient *q_ptr) :
 	query(),
 	attribs(),
 	sslConfig(QSslConfiguration::defaultConfiguration()),
+	autoWarmUp(false),
+	transportProfile(),
+	hasTransportProfile(false),
+	pagingPrefetch(false),
+	pagingOwnsItems(false),
+	syncTimeout(0),
 	nam(new QNetworkAccessManager(q_ptr)),
 	serializer(new QJsonSerializer(q_ptr)),
 	pagingFactory(new StandardPagingFactory()),
-	rootClass(new RestClass(q_ptr, {}, q_ptr))
+	tlsSessionCache(),
+	pageCache(),
+	tracer(),
+	interceptors(),
+	metrics(),
+	rootClass(new RestClass(q_ptr, {}, q_ptr)),
+	q(q_ptr)
 {}
 
+void RestClientPrivate::startRequest(RestClient *client)
+{
+	client->d->metrics.d->inFlight++;
+}
+
+void RestClientPrivate::abandonRequest(RestClient *client)
+{
+	client->d->metrics.d->inFlight--;
+}
+
+void RestClientPrivate::completeRequest(RestClient *client, const RequestMetrics &metrics)
+{
+	client->d->metrics.d->inFlight--;
+	client->d->metrics.d->record(metrics);
+	emit client->requestCompleted(metrics, {});
+}
+
+QSslConfiguration RestClientPrivate::sslConfigFor(const QUrl &url) const
+{
+	if(!tlsSessionCache || url.scheme() != QStringLiteral("https"))
+		return sslConfig;
+	return tlsSessionCache->prepareConfiguration(sslConfig, url.host(), url.port(443));
+}
+
+QHash<QNetworkRequest::Attribute, QVariant> RestClientPrivate::effectiveAttributes() const
+{
+	//explicitly set attributes always win over the profile, which is only used once set
+	QHash<QNetworkRequest::Attribute, QVariant> attributes;
+	if(hasTransportProfile)
+		attributes = transportProfile.attributes();
+	for(auto it = attribs.constBegin(); it != attribs.constEnd(); it++)
+		attributes.insert(it.key(), it.value());
+	return attributes;
+}
+
+void RestClientPrivate::connectManager()
+{
+	QObject::connect(nam, &QNetworkAccessManager::finished, q, [this](QNetworkReply *reply){
+		if(!tlsSessionCache || reply->url().scheme() != QStringLiteral("https"))
+			return;
+		auto config = reply->sslConfiguration();
+		tlsSessionCache->storeSessionTicket(reply->url().host(),
+											reply->url().port(443),
+											config.sessionTicket(),
+											config.sessionTicketLifeTimeHint());
+	});
+}
+
 // ------------- Global header implementation -------------
 
 /*!
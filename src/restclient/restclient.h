@@ -3,6 +3,9 @@
 
 #include "QtRestClient/qtrestclient_global.h"
 #include "QtRestClient/requestbuilder.h"
+#include "QtRestClient/transportprofile.h"
+#include "QtRestClient/requestmetrics.h"
+#include "QtRestClient/metricssnapshot.h"
 
 #include <QtNetwork/qnetworkrequest.h>
 #include <QtCore/qobject.h>
@@ -15,6 +18,11 @@ namespace QtRestClient {
 
 class RestClass;
 class PagingFactory;
+class ParallelDownload;
+class TlsSessionCache;
+class PageCache;
+class Tracer;
+class RequestInterceptor;
 
 class RestClientPrivate;
 //! A class to define access to an API, with general settings
@@ -35,6 +43,16 @@ class Q_RESTCLIENT_EXPORT RestClient : public QObject
 	Q_PROPERTY(QHash<QNetworkRequest::Attribute, QVariant> requestAttributes READ requestAttributes WRITE setRequestAttributes NOTIFY requestAttributesChanged)
 	//! The SSL configuration to be used for HTTPS
 	Q_PROPERTY(QSslConfiguration sslConfiguration READ sslConfiguration WRITE setSslConfiguration NOTIFY sslConfigurationChanged)
+	//! Specifies, whether a connection to the baseUrl should be opened as soon as it changes
+	Q_PROPERTY(bool autoWarmUp READ autoWarmUp WRITE setAutoWarmUp NOTIFY autoWarmUpChanged)
+	//! The HTTP protocol and connection settings to be used for every request
+	Q_PROPERTY(QtRestClient::TransportProfile transportProfile READ transportProfile WRITE setTransportProfile NOTIFY transportProfileChanged)
+	//! The number of pages Paging::iterate requests ahead of the page it is processing
+	Q_PROPERTY(bool pagingPrefetch READ pagingPrefetch WRITE setPagingPrefetch NOTIFY pagingPrefetchChanged)
+	//! Specifies, whether pagings own their QObject items and delete them together once released
+	Q_PROPERTY(bool pagingOwnsItems READ pagingOwnsItems WRITE setPagingOwnsItems NOTIFY pagingOwnsItemsChanged)
+	//! The number of milliseconds a synchronous call waits for its reply, or 0 to wait forever
+	Q_PROPERTY(int syncTimeout READ syncTimeout WRITE setSyncTimeout NOTIFY syncTimeoutChanged)
 
 public:
 	//! Constructor
@@ -52,6 +70,14 @@ public:
 	QJsonSerializer *serializer() const;
 	//! Returns the paging factory used by the restclient
 	PagingFactory *pagingFactory() const;
+	//! Returns the TLS session cache used by the restclient, if any
+	TlsSessionCache *tlsSessionCache() const;
+	//! Returns the page cache used by pagings of the restclient, if any
+	PageCache *pageCache() const;
+	//! Returns the tracer used by the restclient, if any
+	Tracer *tracer() const;
+	//! Returns the interceptors of the restclient, in the order they see requests
+	QList<RequestInterceptor*> interceptors() const;
 
 	//! @readAcFn{RestClient::baseUrl}
 	QUrl baseUrl() const;
@@ -65,10 +91,26 @@ public:
 	QHash<QNetworkRequest::Attribute, QVariant> requestAttributes() const;
 	//! @readAcFn{RestClient::sslConfiguration}
 	QSslConfiguration sslConfiguration() const;
+	//! @readAcFn{RestClient::autoWarmUp}
+	bool autoWarmUp() const;
+	//! @readAcFn{RestClient::transportProfile}
+	TransportProfile transportProfile() const;
+	//! @readAcFn{RestClient::pagingPrefetch}
+	bool pagingPrefetch() const;
+	//! @readAcFn{RestClient::pagingOwnsItems}
+	bool pagingOwnsItems() const;
+	//! @readAcFn{RestClient::syncTimeout}
+	int syncTimeout() const;
 
 	//! Creates a request builder with all the settings of this client
 	virtual RequestBuilder builder() const;
 
+	//! Returns the aggregated metrics of all requests of this client
+	MetricsSnapshot metricsSnapshot() const;
+
+	//! Downloads the resource at the relative URL into a file, using concurrent byte ranges
+	ParallelDownload *download(const QUrl &relativeUrl, const QString &filePath, int parallelism = 4);
+
 public Q_SLOTS:
 	//! Sets the network access manager to be used by all requests for this client
 	void setManager(QNetworkAccessManager *manager);
@@ -76,6 +118,18 @@ public Q_SLOTS:
 	void setSerializer(QJsonSerializer *serializer);
 	//! Sets the paging factory to be used by all paging requests for this client
 	void setPagingFactory(PagingFactory *factory);
+	//! Sets the TLS session cache to resume HTTPS sessions with. Pass `nullptr` to disable it
+	void setTlsSessionCache(TlsSessionCache *cache);
+	//! Sets the cache to serve revisited pages from. Pass `nullptr` to disable it
+	void setPageCache(PageCache *cache);
+	//! Sets the tracer to propagate trace context and export spans with. Pass `nullptr` to disable tracing
+	void setTracer(Tracer *tracer);
+	//! Appends an interceptor to the end of the interceptor chain
+	void addInterceptor(RequestInterceptor *interceptor);
+	//! Inserts an interceptor into the interceptor chain at the given position
+	void insertInterceptor(int index, RequestInterceptor *interceptor);
+	//! Removes an interceptor from the interceptor chain
+	void removeInterceptor(RequestInterceptor *interceptor);
 
 	//! @writeAcFn{RestClient::baseUrl}
 	void setBaseUrl(QUrl baseUrl);
@@ -91,6 +145,19 @@ public Q_SLOTS:
 	void setModernAttributes();
 	//! @writeAcFn{RestClient::sslConfiguration}
 	void setSslConfiguration(QSslConfiguration sslConfiguration);
+	//! @writeAcFn{RestClient::autoWarmUp}
+	void setAutoWarmUp(bool autoWarmUp);
+	//! @writeAcFn{RestClient::transportProfile}
+	void setTransportProfile(TransportProfile transportProfile);
+	//! @writeAcFn{RestClient::pagingPrefetch}
+	void setPagingPrefetch(bool pagingPrefetch);
+	//! @writeAcFn{RestClient::pagingOwnsItems}
+	void setPagingOwnsItems(bool pagingOwnsItems);
+	//! @writeAcFn{RestClient::syncTimeout}
+	void setSyncTimeout(int syncTimeout);
+
+	//! Opens a connection to the host of the baseUrl, before any request is sent
+	void warmUp();
 
 	//! @writeAcFn{RestClient::globalHeaders}
 	void addGlobalHeader(QByteArray name, QByteArray value);
@@ -120,6 +187,19 @@ Q_SIGNALS:
 	void requestAttributesChanged(QHash<QNetworkRequest::Attribute, QVariant> requestAttributes, QPrivateSignal);
 	//! @notifyAcFn{RestClient::sslConfiguration}
 	void sslConfigurationChanged(QSslConfiguration sslConfiguration, QPrivateSignal);
+	//! @notifyAcFn{RestClient::autoWarmUp}
+	void autoWarmUpChanged(bool autoWarmUp, QPrivateSignal);
+	//! @notifyAcFn{RestClient::transportProfile}
+	void transportProfileChanged(QtRestClient::TransportProfile transportProfile, QPrivateSignal);
+	//! @notifyAcFn{RestClient::pagingPrefetch}
+	void pagingPrefetchChanged(bool pagingPrefetch, QPrivateSignal);
+	//! @notifyAcFn{RestClient::pagingOwnsItems}
+	void pagingOwnsItemsChanged(bool pagingOwnsItems, QPrivateSignal);
+	//! @notifyAcFn{RestClient::syncTimeout}
+	void syncTimeoutChanged(int syncTimeout, QPrivateSignal);
+
+	//! Is emitted whenever a reply of a request created by this client has been handled completely
+	void requestCompleted(const QtRestClient::RequestMetrics &metrics, QPrivateSignal);
 
 private:
 	QScopedPointer<RestClientPrivate> d;
@@ -18,7 +18,39 @@ HEADERS +=  \
 	restreply.h \
 	simple.h \
 	metacomponent.h \
-	standardpaging_p.h
+	standardpaging_p.h \
+	paralleldownload.h \
+	paralleldownload_p.h \
+	tlssessioncache.h \
+	tlssessioncache_p.h \
+	transportprofile.h \
+	requestbuilder_p.h \
+	requestmetrics.h \
+	requestmetrics_p.h \
+	metricssnapshot.h \
+	metricssnapshot_p.h \
+	tracer.h \
+	tracer_p.h \
+	requestinterceptor.h \
+	staticreply.h \
+	staticreply_p.h \
+	authenticator.h \
+	authenticator_p.h \
+	requestsigner.h \
+	requestsigner_p.h \
+	offlinequeue.h \
+	offlinequeue_p.h \
+	restreplyexception.h \
+	awaitable.h \
+	futureutils.h \
+	result.h \
+	pagingstream.h \
+	pagecache.h \
+	pagecache_p.h \
+	linkheaderpaging.h \
+	cursorpaging.h \
+	pagingmodel.h \
+	pagingmodel_p.h
 
 SOURCES += \
 	requestbuilder.cpp \
@@ -26,7 +58,23 @@ SOURCES += \
 	restclient.cpp \
 	restreply.cpp \
 	standardpaging.cpp \
-	ipaging.cpp
+	ipaging.cpp \
+	paralleldownload.cpp \
+	tlssessioncache.cpp \
+	transportprofile.cpp \
+	requestmetrics.cpp \
+	metricssnapshot.cpp \
+	tracer.cpp \
+	requestinterceptor.cpp \
+	staticreply.cpp \
+	authenticator.cpp \
+	requestsigner.cpp \
+	offlinequeue.cpp \
+	restreplyexception.cpp \
+	pagecache.cpp \
+	linkheaderpaging.cpp \
+	cursorpaging.cpp \
+	pagingmodel.cpp
 
 load(qt_module)
 
@@ -3,6 +3,14 @@
 
 #include <QtJsonSerializer/QJsonSerializer>
 #include "restclient.h"
+#include "tlssessioncache.h"
+#include "pagecache.h"
+#include "metricssnapshot.h"
+#include "tracer.h"
+#include "requestinterceptor.h"
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QPointer>
 
 namespace QtRestClient {
 
@@ -19,14 +27,36 @@ public:
 	QUrlQuery query;
 	QHash<QNetworkRequest::Attribute, QVariant> attribs;
 	QSslConfiguration sslConfig;
+	bool autoWarmUp;
+	TransportProfile transportProfile;
+	bool hasTransportProfile;
+	bool pagingPrefetch;
+	bool pagingOwnsItems;
+	QAtomicInt syncTimeout;
 
 	QNetworkAccessManager *nam;
 	QJsonSerializer *serializer;
 	QScopedPointer<PagingFactory> pagingFactory;
+	QPointer<TlsSessionCache> tlsSessionCache;
+	QPointer<PageCache> pageCache;
+	QPointer<Tracer> tracer;
+	QList<QPointer<RequestInterceptor>> interceptors;
+	MetricsSnapshot metrics;
 
 	RestClass *rootClass;
 
 	RestClientPrivate(RestClient *q_ptr);
+
+	static void startRequest(RestClient *client);
+	static void abandonRequest(RestClient *client);
+	static void completeRequest(RestClient *client, const RequestMetrics &metrics);
+
+	QSslConfiguration sslConfigFor(const QUrl &url) const;
+	QHash<QNetworkRequest::Attribute, QVariant> effectiveAttributes() const;
+	void connectManager();
+
+private:
+	RestClient *q;
 };
 
 }
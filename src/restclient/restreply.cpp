@@ -1,5 +1,10 @@
 #include "restreply.h"
 #include "restreply_p.h"
+#include "restclient_p.h"
+#include "requestbuilder_p.h"
+#include "requestmetrics_p.h"
+#include "tracer_p.h"
+#include "genericrestreply.h"
 
 #include <QtCore/QBuffer>
 #include <QtCore/QJsonDocument>
@@ -12,6 +17,11 @@ RestReply::RestReply(QNetworkReply *networkReply, QObject *parent) :
 	QObject(parent),
 	d(new RestReplyPrivate(networkReply, this))
 {
+	//completed signal, once for the reply instead of every attempt
+	connect(this, SIGNAL(succeeded(int,QJsonValue)),
+			this, SIGNAL(completed(int,QJsonValue)));
+	connect(this, SIGNAL(failed(int,QJsonValue)),
+			this, SIGNAL(completed(int,QJsonValue)));
 	d->connectReply(networkReply);
 }
 
@@ -109,8 +119,29 @@ QNetworkReply *RestReply::networkReply() const
 	return d->networkReply.data();
 }
 
+TransportProfile::Protocol RestReply::usedProtocol() const
+{
+	return TransportProfile::usedProtocol(d->networkReply.data());
+}
+
+RequestMetrics RestReply::metrics() const
+{
+	return d->metrics;
+}
+
+QFuture<QJsonValue> RestReply::toFuture()
+{
+	QFutureInterface<QJsonValue> futureInterface;
+	Private::connectFuture(this, futureInterface);
+	connect(this, &RestReply::succeeded, this, [=](int, const QJsonValue &value) mutable {
+		futureInterface.reportFinished(&value);
+	});
+	return futureInterface.future();
+}
+
 void RestReply::abort()
 {
+	d->aborted = true;
 	d->networkReply->abort();
 }
 
@@ -156,64 +187,138 @@ QByteArray RestReply::jsonTypeName(QJsonValue::Type type)
 	}
 }
 
+void RestReply::recordPhase(RequestMetrics::Phase phase)
+{
+	d->recordPhase(phase);
+}
+
 // ------------- Private Implementation -------------
 
 const QByteArray RestReplyPrivate::PropertyVerb("__QtRestClient_RestReplyPrivate_PropertyVerb");
 const QByteArray RestReplyPrivate::PropertyBuffer("__QtRestClient_RestReplyPrivate_PropertyBuffer");
-
-QIODevice *RestReplyPrivate::cloneDevice(QIODevice *device)
+const QByteArray RestReplyPrivate::PropertyMultiPart("__QtRestClient_RestReplyPrivate_PropertyMultiPart");
+const QByteArray RestReplyPrivate::PropertyOwnsBuffer("__QtRestClient_RestReplyPrivate_PropertyOwnsBuffer");
+const QByteArray RestReplyPrivate::PropertyRoute("__QtRestClient_RestReplyPrivate_PropertyRoute");
+const QByteArray RestReplyPrivate::PropertyParentSpan("__QtRestClient_RestReplyPrivate_PropertyParentSpan");
+const QByteArray RestReplyPrivate::PropertyRestReply("__QtRestClient_RestReplyPrivate_PropertyRestReply");
+const QByteArray RestReplyPrivate::PropertyInterceptors("__QtRestClient_RestReplyPrivate_PropertyInterceptors");
+const QByteArray RestReplyPrivate::PropertyBuilder("__QtRestClient_RestReplyPrivate_PropertyBuilder");
+const QList<QByteArray> RestReplyPrivate::ForwardedProperties {
+	RestReplyPrivate::PropertyRoute,
+	RestReplyPrivate::PropertyParentSpan,
+	RestReplyPrivate::PropertyInterceptors
+};
+
+QIODevice *RestReplyPrivate::reuseDevice(QIODevice *device)
 {
-	if(device->isSequential())
+	//rewind instead of copying, so streamed bodies are never buffered completely
+	if(!device || device->isSequential() || !device->reset())
 		return nullptr;
-	else {
-		auto rPos = device->pos();
-		device->seek(0);
-
-		auto buffer = new QBuffer();
-		buffer->setData(device->readAll());
-		buffer->open(QIODevice::ReadOnly);
-
-		device->seek(rPos);
+	else
+		return device;
+}
 
-		return buffer;
+QByteArray RestReplyPrivate::verbOf(QNetworkReply *reply)
+{
+	auto verb = reply->property(PropertyVerb).toByteArray();
+	if(!verb.isEmpty())
+		return verb;
+
+	switch (reply->operation()) {
+	case QNetworkAccessManager::HeadOperation:
+		return "HEAD";
+	case QNetworkAccessManager::PutOperation:
+		return "PUT";
+	case QNetworkAccessManager::PostOperation:
+		return "POST";
+	case QNetworkAccessManager::DeleteOperation:
+		return "DELETE";
+	case QNetworkAccessManager::CustomOperation:
+		return reply->request().attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+	default:
+		return "GET";
 	}
 }
 
-QNetworkReply *RestReplyPrivate::compatSend(QNetworkAccessManager *nam, QNetworkRequest request, QByteArray verb, QIODevice *buffer)
+QNetworkReply *RestReplyPrivate::compatSend(QNetworkAccessManager *nam, QNetworkRequest request, QByteArray verb, QIODevice *buffer, bool ownsBuffer)
 {
-	auto reply = nam->sendCustomRequest(request, verb, buffer);
+	auto reply = nam ? nam->sendCustomRequest(request, verb, buffer) : nullptr;
 	if(reply) {
 		reply->setProperty(PropertyVerb, verb);
 		if(buffer) {
 			reply->setProperty(PropertyBuffer, QVariant::fromValue(buffer));
-			QObject::connect(reply, &QNetworkReply::destroyed, [=](){
-				buffer->close();
-				buffer->deleteLater();
-			});
+			//only buffers created internally are owned, devices of the caller stay theirs
+			if(ownsBuffer) {
+				reply->setProperty(PropertyOwnsBuffer, true);
+				buffer->setParent(reply);
+			} else {
+				QObject::connect(buffer, &QObject::destroyed, reply, [reply](){
+					reply->setProperty(PropertyBuffer, QVariant::fromValue<QIODevice*>(nullptr));
+				});
+			}
 		}
-	} else if(buffer) {
+	} else if(buffer && ownsBuffer) {
 		buffer->close();
 		buffer->deleteLater();
 	}
 	return reply;
 }
 
+QNetworkReply *RestReplyPrivate::compatSend(QNetworkAccessManager *nam, QNetworkRequest request, QByteArray verb, MultiPartBody *multiPart)
+{
+	QNetworkReply *reply = nullptr;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+	if(nam)
+		reply = nam->sendCustomRequest(request, verb, multiPart);
+#else
+	if(nam && verb == "PUT")
+		reply = nam->put(request, multiPart);
+	else if(nam)
+		reply = nam->post(request, multiPart);
+#endif
+	if(reply) {
+		reply->setProperty(PropertyVerb, verb);
+		reply->setProperty(PropertyMultiPart, QVariant::fromValue<QHttpMultiPart*>(multiPart));
+		multiPart->setParent(reply);
+	} else
+		multiPart->deleteLater();
+	return reply;
+}
+
 RestReplyPrivate::RestReplyPrivate(QNetworkReply *networkReply, RestReply *q_ptr) :
 	QObject(q_ptr),
 	networkReply(networkReply),
 	autoDelete(true),
 	retryDelay(-1),
+	client(networkReply ? qobject_cast<RestClient*>(networkReply->request().originatingObject()) : nullptr),
+	timer(),
+	metrics(),
+	retryCount(0),
+	inFlight(false),
+	aborted(false),
+	parked(false),
+	parkedStatus(0),
+	parkedData(),
+	retryHeaders(),
 	q(q_ptr)
 {}
 
 RestReplyPrivate::~RestReplyPrivate()
 {
+	if(inFlight && client)
+		RestClientPrivate::abandonRequest(client);
 	if(networkReply)
 		networkReply->deleteLater();
 }
 
+RestReplyPrivate *RestReplyPrivate::of(QNetworkReply *reply)
+{
+	return qobject_cast<RestReplyPrivate*>(reply->property(PropertyRestReply).value<QObject*>());
+}
+
 void RestReplyPrivate::connectReply(QNetworkReply *reply)
 {
+	reply->setProperty(PropertyRestReply, QVariant::fromValue<QObject*>(this));
 	connect(reply, &QNetworkReply::finished,
 			this, &RestReplyPrivate::replyFinished);
 
@@ -227,19 +332,83 @@ void RestReplyPrivate::connectReply(QNetworkReply *reply)
 	connect(reply, &QNetworkReply::uploadProgress,
 			q, &RestReply::uploadProgress);
 
-	//completed signal
-	connect(q, SIGNAL(succeeded(int,QJsonValue)),
-			q, SIGNAL(completed(int,QJsonValue)));
-	connect(q, SIGNAL(failed(int,QJsonValue)),
-			q, SIGNAL(completed(int,QJsonValue)));
+	startMetrics(reply);
+}
+
+void RestReplyPrivate::startMetrics(QNetworkReply *reply)
+{
+	metrics = RequestMetrics();
+	metrics.d->url = reply->url();
+	metrics.d->verb = verbOf(reply);
+	metrics.d->route = reply->property(PropertyRoute).toString();
+	metrics.d->traceParent = reply->request().rawHeader(Tracer::TraceParentHeader);
+	metrics.d->parentSpanId = reply->property(PropertyParentSpan).toByteArray();
+	metrics.d->retryCount = retryCount;
+	timer.start();
+	recordPhase(RequestMetrics::Created);
+	if(client && !inFlight) {
+		inFlight = true;
+		RestClientPrivate::startRequest(client);
+	}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	connect(reply, &QNetworkReply::requestSent, this, [this](){
+		recordPhase(RequestMetrics::Sent);
+	});
+#endif
+	//older versions of Qt only report when the body has been written
+	connect(reply, &QNetworkReply::uploadProgress, this, [this](qint64 bytesSent, qint64 bytesTotal){
+		metrics.d->bytesSent = bytesSent;
+		if(bytesTotal > 0 && bytesSent == bytesTotal)
+			recordPhase(RequestMetrics::Sent);
+	});
+	connect(reply, &QNetworkReply::encrypted, this, [this](){
+		recordPhase(RequestMetrics::Encrypted);
+	});
+	connect(reply, &QNetworkReply::metaDataChanged, this, [this](){
+		recordPhase(RequestMetrics::FirstByte);
+	});
+}
+
+void RestReplyPrivate::recordPhase(RequestMetrics::Phase phase)
+{
+	//only the first time counts, i.e. for multiple deserializing handlers
+	if(timer.isValid() && metrics.d->timestamps[phase] < 0)
+		metrics.d->timestamps[phase] = timer.nsecsElapsed();
 }
 
 void RestReplyPrivate::replyFinished()
 {
 	retryDelay = -1;
+	recordPhase(RequestMetrics::Finished);
 
 	//read json first to allow data for certain network fails
 	auto readData = networkReply->readAll();
+	auto status = networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	metrics.d->bytesReceived = readData.size();
+
+	//the interceptors that have seen the request see the reply, in reverse order
+	auto interceptors = networkReply->property(PropertyInterceptors).value<QList<QPointer<RequestInterceptor>>>();
+	for(auto i = interceptors.size() - 1; i >= 0; i--) {
+		if(interceptors[i])
+			interceptors[i]->interceptReply(networkReply, status, readData);
+	}
+
+	metrics.d->status = status;
+	metrics.d->networkError = networkReply->error();
+	metrics.d->protocol = TransportProfile::usedProtocol(networkReply);
+	metrics.d->fromCache = networkReply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+
+	//parked replies are held back from the handlers until they are resumed
+	if(parked) {
+		parkedStatus = status;
+		parkedData = readData;
+	} else
+		processReply(status, readData);
+}
+
+void RestReplyPrivate::processReply(int status, const QByteArray &readData)
+{
 	QJsonParseError jError;
 	auto jDoc = QJsonDocument::fromJson(readData, &jError);
 	QJsonValue jValue;
@@ -247,9 +416,9 @@ void RestReplyPrivate::replyFinished()
 		jValue = jDoc.object();
 	else if(jDoc.isArray())
 		jValue = jDoc.array();
+	recordPhase(RequestMetrics::Parsed);
 
 	//check "http errors", because they can have data, but only if json is valid
-	auto status = networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
 	if(jError.error == QJsonParseError::NoError && status >= 300)//first: status code error + valid json
 		emit q->failed(status, jValue, {});
 	else if(networkReply->error() != QNetworkReply::NoError)//next: check normal network errors
@@ -261,6 +430,12 @@ void RestReplyPrivate::replyFinished()
 		retryDelay = -1;
 	}
 
+	recordPhase(RequestMetrics::HandlerDone);
+	if(client) {
+		inFlight = false;
+		RestClientPrivate::completeRequest(client, metrics);
+	}
+
 	if(retryDelay == 0) {
 		retryDelay = -1;
 		retryReply();
@@ -271,6 +446,41 @@ void RestReplyPrivate::replyFinished()
 		q->deleteLater();
 }
 
+void RestReplyPrivate::resume(bool resend)
+{
+	if(!parked)
+		return;
+	parked = false;
+	auto status = parkedStatus;
+	auto data = parkedData;
+	parkedStatus = 0;
+	parkedData.clear();
+
+	if(resend) {
+		//the parked attempt counts as a request of its own
+		if(client) {
+			inFlight = false;
+			RestClientPrivate::completeRequest(client, metrics);
+		}
+		retryReply();
+	} else
+		processReply(status, data);
+}
+
+bool RestReplyPrivate::isTimeout() const
+{
+	//Qt reports transfer timeouts just like calls of abort()
+	if(aborted || !networkReply || networkReply->error() != QNetworkReply::OperationCanceledError)
+		return false;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	auto nam = networkReply->manager();
+	return networkReply->request().transferTimeout() > 0 ||
+			(nam && nam->transferTimeout() > 0);
+#else
+	return false;
+#endif
+}
+
 void RestReplyPrivate::handleSslErrors(const QList<QSslError> &errors)
 {
 	bool ignore = false;
@@ -282,15 +492,114 @@ void RestReplyPrivate::handleSslErrors(const QList<QSslError> &errors)
 void RestReplyPrivate::retryReply()
 {
 	auto nam = networkReply->manager();
+	//replies created by interceptors have no manager
+	if(!nam && client)
+		nam = client->manager();
 	auto request = networkReply->request();
 	auto verb = networkReply->property(PropertyVerb).toByteArray();
 	if(verb.isEmpty())
 		verb = "GET";
-	auto buffer = networkReply->property(PropertyBuffer).value<QIODevice*>();
-	if(buffer)
-		buffer = cloneDevice(buffer);
+	auto hasBody = networkReply->property(PropertyBuffer).isValid();
+	auto buffer = reuseDevice(networkReply->property(PropertyBuffer).value<QIODevice*>());
+	auto ownsBuffer = networkReply->property(PropertyOwnsBuffer).toBool();
+	auto multiPart = qobject_cast<MultiPartBody*>(networkReply->property(PropertyMultiPart).value<QHttpMultiPart*>());
+	if(multiPart) {
+		hasBody = true;
+		multiPart = multiPart->clone();
+	}
+	//sending without the body would still send the original content headers
+	if(hasBody && !buffer && !multiPart) {
+		failRetry(RestReply::tr("The request body cannot be sent again"), QNetworkReply::ContentReSendError);
+		return;
+	}
+	if(!nam) {
+		delete multiPart;
+		failRetry(RestReply::tr("The request cannot be sent again without a network access manager"), QNetworkReply::ProtocolUnknownError);
+		return;
+	}
+
+	QHash<QByteArray, QVariant> properties;
+	for(auto property : ForwardedProperties) {
+		auto value = networkReply->property(property);
+		if(value.isValid())
+			properties.insert(property, value);
+	}
+	//every attempt is a span of its own
+	auto traceParent = request.rawHeader(Tracer::TraceParentHeader);
+	if(!traceParent.isEmpty())
+		traceParent = TracerPrivate::respan(traceParent);
+
+	QNetworkReply *reply = nullptr;
+	auto builder = networkReply->property(PropertyBuilder).value<QSharedPointer<RequestBuilder>>();
+	if(builder) {
+		//send through the interceptors again, so signatures and tokens are fresh
+		//the builder creates a new body from the devices rewound above
+		delete multiPart;
+		properties.remove(PropertyInterceptors);
+		auto retryBuilder = *builder;
+		retryBuilder.d->nam = nam;
+		if(!traceParent.isEmpty())
+			retryBuilder.addHeader(Tracer::TraceParentHeader, traceParent);
+		for(auto it = retryHeaders.constBegin(); it != retryHeaders.constEnd(); it++)
+			retryBuilder.addHeader(it.key(), it.value());
+		reply = retryBuilder.send();
+	} else {
+		if(!traceParent.isEmpty())
+			request.setRawHeader(Tracer::TraceParentHeader, traceParent);
+		for(auto it = retryHeaders.constBegin(); it != retryHeaders.constEnd(); it++)
+			request.setRawHeader(it.key(), it.value());
+		if(multiPart)
+			reply = compatSend(nam, request, verb, multiPart);
+		else {
+			if(buffer && ownsBuffer)
+				buffer->setParent(nullptr);
+			reply = compatSend(nam, request, verb, buffer, ownsBuffer);
+		}
+	}
+	retryHeaders.clear();
+	if(!reply) {
+		failRetry(RestReply::tr("The request could not be sent again"), QNetworkReply::ProtocolUnknownError);
+		return;
+	}
 
 	networkReply->deleteLater();
-	networkReply = compatSend(nam, request, verb, buffer);
+	networkReply = reply;
+	retryCount++;
+	aborted = false;
+	for(auto it = properties.constBegin(); it != properties.constEnd(); it++) {
+		if(!networkReply->property(it.key()).isValid())
+			networkReply->setProperty(it.key(), it.value());
+	}
 	connectReply(networkReply);
 }
+
+void RestReplyPrivate::failRetry(const QString &errorString, QNetworkReply::NetworkError error)
+{
+	emit q->error(errorString, error, RestReply::NetworkError, {});
+	if(autoDelete)
+		q->deleteLater();
+}
+
+// ------------- Multipart Implementation -------------
+
+MultiPartBody::MultiPartBody(ContentType contentType, const QList<QHttpPart> &parts, const QList<QPointer<QIODevice>> &devices, const QByteArray &boundary) :
+	QHttpMultiPart(contentType),
+	contentType(contentType),
+	parts(parts),
+	devices(devices)
+{
+	if(!boundary.isEmpty())
+		setBoundary(boundary);
+	for(auto part : parts)
+		append(part);
+}
+
+MultiPartBody *MultiPartBody::clone()
+{
+	//the part devices belong to the caller and may be gone already
+	for(auto device : devices) {
+		if(!device || device->isSequential() || !device->reset())
+			return nullptr;
+	}
+	return new MultiPartBody(contentType, parts, devices, boundary());
+}
@@ -2,7 +2,10 @@
 #define QTRESTCLIENT_RESTREPLY_H
 
 #include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/transportprofile.h"
+#include "QtRestClient/requestmetrics.h"
 
+#include <QtCore/qfuture.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsonobject.h>
 #include <QtNetwork/qnetworkreply.h>
@@ -66,6 +69,12 @@ public:
 
 	//! Returns the network reply associated with the rest reply
 	QNetworkReply *networkReply() const;
+	//! Returns the HTTP protocol the reply was actually transferred with
+	TransportProfile::Protocol usedProtocol() const;
+	//! Returns the timing record of the current request
+	RequestMetrics metrics() const;
+	//! Returns a future that finishes with the received value, or a RestReplyException
+	QFuture<QJsonValue> toFuture();
 
 public Q_SLOTS:
 	//! Aborts the request by calling QNetworkReply::abort
@@ -104,6 +113,8 @@ Q_SIGNALS:
 protected:
 	//! @private
 	static QByteArray jsonTypeName(QJsonValue::Type type);
+	//! Records that the current request has reached the given phase
+	void recordPhase(RequestMetrics::Phase phase);
 
 private:
 	RestReplyPrivate *d;
@@ -2,11 +2,34 @@
 #define QTRESTCLIENT_RESTREPLY_P_H
 
 #include "restreply.h"
+#include "restclient.h"
+#include "requestinterceptor.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QPointer>
+#include <QtCore/QSharedPointer>
+#include <QtNetwork/QHttpMultiPart>
 
 namespace QtRestClient {
 
+class Q_RESTCLIENT_EXPORT MultiPartBody : public QHttpMultiPart
+{
+	Q_OBJECT
+
+public:
+	MultiPartBody(ContentType contentType,
+				  const QList<QHttpPart> &parts,
+				  const QList<QPointer<QIODevice>> &devices,
+				  const QByteArray &boundary = QByteArray());
+
+	MultiPartBody *clone();
+
+private:
+	ContentType contentType;
+	QList<QHttpPart> parts;
+	QList<QPointer<QIODevice>> devices;
+};
+
 class Q_RESTCLIENT_EXPORT RestReplyPrivate : public QObject
 {
 	Q_OBJECT
@@ -14,18 +37,47 @@ class Q_RESTCLIENT_EXPORT RestReplyPrivate : public QObject
 public:
 	static const QByteArray PropertyVerb;
 	static const QByteArray PropertyBuffer;
+	static const QByteArray PropertyMultiPart;
+	static const QByteArray PropertyOwnsBuffer;
+	static const QByteArray PropertyRoute;
+	static const QByteArray PropertyParentSpan;
+	static const QByteArray PropertyInterceptors;
+	static const QByteArray PropertyRestReply;
+	static const QByteArray PropertyBuilder;
+	static const QList<QByteArray> ForwardedProperties;
 
-	static QIODevice *cloneDevice(QIODevice *device);
-	static QNetworkReply *compatSend(QNetworkAccessManager *nam, QNetworkRequest request, QByteArray verb, QIODevice *buffer);
+	static QIODevice *reuseDevice(QIODevice *device);
+	static QNetworkReply *compatSend(QNetworkAccessManager *nam, QNetworkRequest request, QByteArray verb, QIODevice *buffer, bool ownsBuffer = false);
+	static QNetworkReply *compatSend(QNetworkAccessManager *nam, QNetworkRequest request, QByteArray verb, MultiPartBody *multiPart);
+
+	static QByteArray verbOf(QNetworkReply *reply);
+	static RestReplyPrivate *of(QNetworkReply *reply);
 
 	QPointer<QNetworkReply> networkReply;
 	bool autoDelete;
 	int retryDelay;
 
+	QPointer<RestClient> client;
+	QElapsedTimer timer;
+	RequestMetrics metrics;
+	int retryCount;
+	bool inFlight;
+	bool aborted;
+
+	bool parked;
+	int parkedStatus;
+	QByteArray parkedData;
+	HeaderHash retryHeaders;
+
 	RestReplyPrivate(QNetworkReply *networkReply, RestReply *q_ptr);
 	~RestReplyPrivate();
 
 	void connectReply(QNetworkReply *reply);
+	void startMetrics(QNetworkReply *reply);
+	void recordPhase(RequestMetrics::Phase phase);
+	void processReply(int status, const QByteArray &readData);
+	void resume(bool resend);
+	bool isTimeout() const;
 
 public Q_SLOTS:
 	void replyFinished();
@@ -35,9 +87,13 @@ private Q_SLOTS:
 	void retryReply();
 
 private:
+	void failRetry(const QString &errorString, QNetworkReply::NetworkError error);
+
 	RestReply *q;
 };
 
 }
 
+Q_DECLARE_METATYPE(QSharedPointer<QtRestClient::RequestBuilder>)
+
 #endif // QTRESTCLIENT_RESTREPLY_P_H
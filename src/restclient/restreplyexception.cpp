@@ -0,0 +1,55 @@
+#include "restreplyexception.h"
+using namespace QtRestClient;
+
+RestReplyException::RestReplyException(int httpStatus, const QJsonValue &reply) :
+	QException(),
+	_errorType(RestReply::FailureError),
+	_error(httpStatus),
+	_errorString(),
+	_reply(reply),
+	_what("Request failed with HTTP status " + QByteArray::number(httpStatus))
+{}
+
+RestReplyException::RestReplyException(const QString &errorString, int error, RestReply::ErrorType errorType) :
+	QException(),
+	_errorType(errorType),
+	_error(error),
+	_errorString(errorString),
+	_reply(),
+	_what(errorString.toUtf8())
+{}
+
+RestReply::ErrorType RestReplyException::errorType() const
+{
+	return _errorType;
+}
+
+int RestReplyException::error() const
+{
+	return _error;
+}
+
+QString RestReplyException::errorString() const
+{
+	return _errorString;
+}
+
+QJsonValue RestReplyException::reply() const
+{
+	return _reply;
+}
+
+const char *RestReplyException::what() const noexcept
+{
+	return _what.constData();
+}
+
+void RestReplyException::raise() const
+{
+	throw *this;
+}
+
+QException *RestReplyException::clone() const
+{
+	return new RestReplyException(*this);
+}
@@ -0,0 +1,48 @@
+#ifndef QTRESTCLIENT_RESTREPLYEXCEPTION_H
+#define QTRESTCLIENT_RESTREPLYEXCEPTION_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/restreply.h"
+
+#include <QtCore/qexception.h>
+#include <QtCore/qjsonvalue.h>
+
+namespace QtRestClient {
+
+//! An exception that represents a reply that did not succeed
+class Q_RESTCLIENT_EXPORT RestReplyException : public QException
+{
+public:
+	//! Creates an exception for a reply that failed with the given status and data
+	RestReplyException(int httpStatus, const QJsonValue &reply);
+	//! Creates an exception for a reply that had an error
+	RestReplyException(const QString &errorString, int error, RestReply::ErrorType errorType);
+
+	//! Returns the type of the error
+	RestReply::ErrorType errorType() const;
+	//! Returns the error code, or the HTTP status code for failures
+	int error() const;
+	//! Returns a description of the error. Is empty for failures
+	QString errorString() const;
+	//! Returns the data the server sent with a failure
+	QJsonValue reply() const;
+
+	//! @inherit{std::exception::what}
+	const char *what() const noexcept override;
+
+	//! @inherit{QException::raise}
+	void raise() const override;
+	//! @inherit{QException::clone}
+	QException *clone() const override;
+
+private:
+	RestReply::ErrorType _errorType;
+	int _error;
+	QString _errorString;
+	QJsonValue _reply;
+	QByteArray _what;
+};
+
+}
+
+#endif // QTRESTCLIENT_RESTREPLYEXCEPTION_H
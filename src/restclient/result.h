@@ -0,0 +1,192 @@
+#ifndef QTRESTCLIENT_RESULT_H
+#define QTRESTCLIENT_RESULT_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/restreplyexception.h"
+
+#include <QtCore/qfuture.h>
+#include <QtCore/qsharedpointer.h>
+#include <utility>
+
+namespace QtRestClient {
+
+//! The outcome of a synchronous request, either a value or an error
+template <typename T, typename TError = RestReplyException>
+class Result
+{
+public:
+	//! Creates a successful result with the given value
+	Result(T value);
+	//! Creates a failed result with the given error
+	Result(const TError &error);
+
+	//! Returns true, if the result holds a value
+	bool isSuccess() const;
+	//! @copydoc isSuccess
+	explicit operator bool() const;
+
+	//! Returns the value, or throws the error if the result has none
+	T value() const;
+	//! Returns the value, or the given default if the result has none
+	T valueOr(T defaultValue) const;
+	//! Returns the error. Must only be called for failed results
+	TError error() const;
+
+	//! Waits for the future to finish and returns its result, without an event loop
+	static Result<T, TError> fromFuture(QFuture<T> future);
+
+private:
+	T _value;
+	QSharedPointer<TError> _error;
+};
+
+//! @copydoc QtRestClient::Result
+template <typename TError>
+class Result<void, TError>
+{
+public:
+	//! Creates a successful result
+	Result();
+	//! @copydoc Result::Result(const TError &)
+	Result(const TError &error);
+
+	//! @copydoc Result::isSuccess
+	bool isSuccess() const;
+	//! @copydoc Result::isSuccess
+	explicit operator bool() const;
+
+	//! Throws the error, if the result failed
+	void value() const;
+	//! @copydoc Result::error
+	TError error() const;
+
+	//! @copydoc Result::fromFuture
+	static Result<void, TError> fromFuture(QFuture<void> future);
+
+private:
+	QSharedPointer<TError> _error;
+};
+
+namespace Private {
+
+inline RestReplyException canceledError()
+{
+	return RestReplyException(QStringLiteral("Operation canceled"),
+							  QNetworkReply::OperationCanceledError,
+							  RestReply::NetworkError);
+}
+
+}
+
+// ------------- Generic Implementation -------------
+
+template<typename T, typename TError>
+Result<T, TError>::Result(T value) :
+	_value(std::move(value)),
+	_error()
+{}
+
+template<typename T, typename TError>
+Result<T, TError>::Result(const TError &error) :
+	_value(),
+	_error(new TError(error))
+{}
+
+template<typename T, typename TError>
+bool Result<T, TError>::isSuccess() const
+{
+	return !_error;
+}
+
+template<typename T, typename TError>
+Result<T, TError>::operator bool() const
+{
+	return !_error;
+}
+
+template<typename T, typename TError>
+T Result<T, TError>::value() const
+{
+	if(_error)
+		_error->raise();
+	return _value;
+}
+
+template<typename T, typename TError>
+T Result<T, TError>::valueOr(T defaultValue) const
+{
+	return _error ? defaultValue : _value;
+}
+
+template<typename T, typename TError>
+TError Result<T, TError>::error() const
+{
+	Q_ASSERT_X(_error, Q_FUNC_INFO, "error() must only be called for failed results");
+	return *_error;
+}
+
+template<typename T, typename TError>
+Result<T, TError> Result<T, TError>::fromFuture(QFuture<T> future)
+{
+	try {
+		future.waitForFinished();
+		if(future.isCanceled())
+			return Private::canceledError();
+		return future.result();
+	} catch(TError &error) {
+		return error;
+	}
+}
+
+template<typename TError>
+Result<void, TError>::Result() :
+	_error()
+{}
+
+template<typename TError>
+Result<void, TError>::Result(const TError &error) :
+	_error(new TError(error))
+{}
+
+template<typename TError>
+bool Result<void, TError>::isSuccess() const
+{
+	return !_error;
+}
+
+template<typename TError>
+Result<void, TError>::operator bool() const
+{
+	return !_error;
+}
+
+template<typename TError>
+void Result<void, TError>::value() const
+{
+	if(_error)
+		_error->raise();
+}
+
+template<typename TError>
+TError Result<void, TError>::error() const
+{
+	Q_ASSERT_X(_error, Q_FUNC_INFO, "error() must only be called for failed results");
+	return *_error;
+}
+
+template<typename TError>
+Result<void, TError> Result<void, TError>::fromFuture(QFuture<void> future)
+{
+	try {
+		future.waitForFinished();
+		if(future.isCanceled())
+			return Private::canceledError();
+		return {};
+	} catch(TError &error) {
+		return error;
+	}
+}
+
+}
+
+#endif // QTRESTCLIENT_RESULT_H
@@ -4,6 +4,7 @@
 #include "QtRestClient/qtrestclient_global.h"
 #include "QtRestClient/genericrestreply.h"
 #include "QtRestClient/restclass.h"
+#include "QtRestClient/futureutils.h"
 
 #include <QtCore/qpointer.h>
 #include <QtCore/qsharedpointer.h>
@@ -58,6 +59,33 @@ public:
 				std::function<void(QString, int, RestReply::ErrorType)> errorHandler = {},
 				std::function<QString(ET, int)> failureTransformer = {});
 
+	//! @brief Extends all given objects, with one request per distinct extension href
+	//! @param client The rest client to be used to create the network requests
+	//! @param objects The objects to be extended
+	//! @param maxConcurrent The maximum number of requests to be running at the same time
+	//! @returns A future with the loaded extensions, one per distinct href
+	static QFuture<T*> extendAll(RestClient *client,
+								 const QList<Simple<T*>*> &objects,
+								 int maxConcurrent = 4);
+	//! @brief Extends all given objects with requests to an endpoint that returns many extensions at once
+	//! @param client The rest client to be used to create the network requests
+	//! @param objects The objects to be extended
+	//! @param bulkPath The path of the endpoint, relative to the clients root class
+	//! @param idProperty The property that identifies an object, in both the simple and the extended type
+	//! @param idsParameter The query parameter to pass the comma separated ids with
+	//! @param batchSize The maximum number of ids per request
+	//! @param maxConcurrent The maximum number of requests to be running at the same time
+	//! @returns A future with the loaded extensions, one list per request
+	//! @details Extensions the server sent for ids that were not requested, or whose objects have
+	//! been deleted in the meantime, are not part of the result and are deleted instead.
+	static QFuture<QList<T*>> extendAll(RestClient *client,
+										const QList<Simple<T*>*> &objects,
+										const QString &bulkPath,
+										const QByteArray &idProperty,
+										const QString &idsParameter = QStringLiteral("ids"),
+										int batchSize = 50,
+										int maxConcurrent = 4);
+
 private:
 	QPointer<T> cExt;
 };
@@ -174,6 +202,85 @@ void Simple<T*, typename std::enable_if<std::is_base_of<QObject, T>::value>::typ
 	}
 }
 
+template<typename T>
+QFuture<T*> Simple<T*, typename std::enable_if<std::is_base_of<QObject, T>::value>::type>::extendAll(RestClient *client, const QList<Simple<T*>*> &objects, int maxConcurrent)
+{
+	//objects that share an href share a single request and extension
+	QList<QUrl> hrefs;
+	QHash<QUrl, QList<QPointer<Simple<T*>>>> targets;
+	for(auto object : objects) {
+		if(!object || object->cExt || !object->hasExtension())
+			continue;
+		auto href = object->extensionHref();
+		if(!targets.contains(href))
+			hrefs.append(href);
+		targets[href].append(object);
+	}
+
+	return mapConcurrent(hrefs, maxConcurrent, [client, targets](const QUrl &href) {
+		auto objects = targets.value(href);
+		return client->rootClass()->get<T*>(href)
+				->onSucceeded([objects](int, T *data){
+					for(auto object : objects) {
+						if(object)
+							object->cExt = data;
+					}
+				})
+				->toFuture();
+	});
+}
+
+template<typename T>
+QFuture<QList<T*>> Simple<T*, typename std::enable_if<std::is_base_of<QObject, T>::value>::type>::extendAll(RestClient *client, const QList<Simple<T*>*> &objects, const QString &bulkPath, const QByteArray &idProperty, const QString &idsParameter, int batchSize, int maxConcurrent)
+{
+	QList<QStringList> batches;
+	QHash<QString, QList<QPointer<Simple<T*>>>> targets;
+	for(auto object : objects) {
+		if(!object || object->cExt || !object->hasExtension())
+			continue;
+		auto id = object->property(idProperty.constData()).toString();
+		if(id.isEmpty())
+			continue;
+		if(!targets.contains(id)) {
+			if(batches.isEmpty() || batches.last().size() >= qMax(1, batchSize))
+				batches.append(QStringList());
+			batches.last().append(id);
+		}
+		targets[id].append(object);
+	}
+
+	return mapConcurrent(batches, maxConcurrent, [client, targets, bulkPath, idProperty, idsParameter](const QStringList &ids) {
+		//reports only the extensions that have been assigned, instead of the raw reply
+		QFutureInterface<QList<T*>> futureInterface;
+		auto reply = client->rootClass()->get<QList<T*>>(bulkPath, {{idsParameter, ids.join(QLatin1Char(','))}});
+		Private::connectFuture(reply, futureInterface);
+		reply->onSucceeded([targets, idProperty, futureInterface](int, QList<T*> data) mutable {
+			QList<T*> extensions;
+			for(auto extension : data) {
+				auto id = extension->property(idProperty.constData()).toString();
+				auto assigned = false;
+				for(auto object : targets.value(id)) {
+					if(object) {
+						object->cExt = extension;
+						assigned = true;
+					}
+				}
+				//not requested, or all of its objects are gone
+				if(assigned)
+					extensions.append(extension);
+				else
+					extension->deleteLater();
+			}
+			futureInterface.reportFinished(&extensions);
+		});
+		reply->onSerializeException([futureInterface](QJsonSerializerException &exception) mutable {
+			futureInterface.reportException(RestReplyException(QString::fromUtf8(exception.what()), 0, RestReply::DeserializationError));
+			futureInterface.reportFinished();
+		});
+		return futureInterface.future();
+	});
+}
+
 // ------------- Generic Implementation gadget -------------
 
 template<typename T>
@@ -6,28 +6,31 @@ namespace QtRestClient {
 class StandardPagingPrivate
 {
 public:
-	StandardPagingPrivate();
+	StandardPagingPrivate(const QJsonObject &json, const QUrl &next, const QUrl &previous);
 
+	QJsonObject json;
 	int total;
 	int offset;
 	QUrl prev;
 	QUrl next;
-	QJsonArray items;
-	QJsonObject json;
+
+	mutable bool hasProperties;
+	mutable QVariantMap properties;
 };
 
 }
 
-StandardPaging::StandardPaging() :
+StandardPaging::StandardPaging(const QJsonObject &json, const QUrl &next, const QUrl &previous) :
 	IPaging(),
-	d(new StandardPagingPrivate())
+	d(new StandardPagingPrivate(json, next, previous))
 {}
 
 StandardPaging::~StandardPaging() {}
 
 QJsonArray StandardPaging::items() const
 {
-	return d->items;
+	//shares the data of the original json, no copy is made
+	return d->json.value(QStringLiteral("items")).toArray();
 }
 
 int StandardPaging::total() const
@@ -62,7 +65,11 @@ QUrl StandardPaging::previous() const
 
 QVariantMap StandardPaging::properties() const
 {
-	return QJsonValue(d->json).toVariant().toMap();
+	if(!d->hasProperties) {
+		d->properties = d->json.toVariantMap();
+		d->hasProperties = true;
+	}
+	return d->properties;
 }
 
 QJsonObject StandardPaging::originalJson() const
@@ -70,66 +77,42 @@ QJsonObject StandardPaging::originalJson() const
 	return d->json;
 }
 
-void StandardPaging::setItems(const QJsonArray &items)
-{
-	d->items = items;
-}
-
-void StandardPaging::setTotal(int total)
-{
-	d->total = total;
-}
-
-void StandardPaging::setOffset(int offset)
-{
-	d->offset = offset;
-}
-
-void StandardPaging::setNext(const QUrl &next)
-{
-	d->next = next;
-}
-
-void StandardPaging::setPrevious(const QUrl &previous)
-{
-	d->prev = previous;
-}
-
-void StandardPaging::setJson(const QJsonObject &object)
-{
-	d->json = object;
-}
-
 // ------------- Factory Implementation -------------
 
 IPaging *StandardPagingFactory::createPaging(QJsonSerializer *serializer, const QJsonObject &data) const
 {
+	Q_UNUSED(serializer)
+
 	//validate data and next only -> only ones required
-	if(!validateUrl(data[QStringLiteral("next")]) ||
-	   !data[QStringLiteral("items")].isArray())
+	QUrl next;
+	QUrl previous;
+	auto previousValue = data.value(QStringLiteral("previous"));
+	if(!readUrl(data.value(QStringLiteral("next")), next) ||
+	   (!previousValue.isUndefined() && !readUrl(previousValue, previous)) ||
+	   !data.value(QStringLiteral("items")).isArray())
 		throw QJsonDeserializationException("Given JSON is not a default paging object!");
-	auto paging = new StandardPaging(serializer->deserialize<StandardPaging>(data));
-	paging->setJson(data);
-	return paging;
+	return new StandardPaging(data, next, previous);
 }
 
-bool StandardPagingFactory::validateUrl(const QJsonValue &value)
+bool StandardPagingFactory::readUrl(const QJsonValue &value, QUrl &url)
 {
 	if(value.isNull())
 		return true;
-	else if(value.isString())
-		return QUrl(value.toString()).isValid();
-	else
+	else if(value.isString()) {
+		url = QUrl(value.toString());
+		return url.isValid();
+	} else
 		return false;
 }
 
 // ------------- Private Implementation -------------
 
-StandardPagingPrivate::StandardPagingPrivate() :
-	total(INT_MAX),
-	offset(-1),
-	prev(),
-	next(),
-	items(),
-	json()
+StandardPagingPrivate::StandardPagingPrivate(const QJsonObject &json, const QUrl &next, const QUrl &previous) :
+	json(json),
+	total(json.value(QStringLiteral("total")).toInt(INT_MAX)),
+	offset(json.value(QStringLiteral("offset")).toInt(-1)),
+	prev(previous),
+	next(next),
+	hasProperties(false),
+	properties()
 {}
@@ -11,19 +11,9 @@ namespace QtRestClient {
 class StandardPagingPrivate;
 class Q_RESTCLIENT_EXPORT StandardPaging : public IPaging
 {
-	Q_GADGET
-
-	Q_PROPERTY(QJsonArray items READ items WRITE setItems)
-	Q_PROPERTY(int total READ total WRITE setTotal)
-	Q_PROPERTY(int offset READ offset WRITE setOffset)
-	Q_PROPERTY(QUrl next READ next WRITE setNext)
-	Q_PROPERTY(QUrl previous READ previous WRITE setPrevious)
-
-	friend class StandardPagingFactory;
-
 public:
-	//! Creates a standard paging from a valid json object
-	StandardPaging();
+	//! Creates a standard paging that reads its data from the json object
+	StandardPaging(const QJsonObject &json, const QUrl &next, const QUrl &previous);
 	~StandardPaging();
 
 	QJsonArray items() const override;
@@ -38,13 +28,6 @@ public:
 
 private:
 	QSharedPointer<StandardPagingPrivate> d;
-
-	void setItems(const QJsonArray &items);
-	void setTotal(int total);
-	void setOffset(int offset);
-	void setNext(const QUrl &next);
-	void setPrevious(const QUrl &previous);
-	void setJson(const QJsonObject &object);
 };
 
 class Q_RESTCLIENT_EXPORT StandardPagingFactory : public PagingFactory
@@ -53,7 +36,7 @@ public:
 	IPaging *createPaging(QJsonSerializer *serializer, const QJsonObject &data) const override;
 
 private:
-	static bool validateUrl(const QJsonValue &value);
+	static bool readUrl(const QJsonValue &value, QUrl &url);
 };
 
 }
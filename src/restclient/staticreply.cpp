@@ -0,0 +1,75 @@
+#include "staticreply.h"
+#include "staticreply_p.h"
+
+#include <QtCore/QTimer>
+using namespace QtRestClient;
+
+StaticReply::StaticReply(const QNetworkRequest &request, int status, const QByteArray &data, QObject *parent) :
+	QNetworkReply(parent),
+	d(new StaticReplyPrivate(data))
+{
+	setRequest(request);
+	setUrl(request.url());
+	setAttribute(QNetworkRequest::HttpStatusCodeAttribute, status);
+	setHeader(QNetworkRequest::ContentLengthHeader, data.size());
+	open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+	//finish asynchronously, like a real reply, so the caller can connect first
+	QTimer::singleShot(0, this, [this](){
+		StaticReplyPrivate::finish(this);
+	});
+}
+
+StaticReply::~StaticReply() {}
+
+bool StaticReply::isSequential() const
+{
+	return true;
+}
+
+qint64 StaticReply::bytesAvailable() const
+{
+	return (d->data.size() - d->offset) + QNetworkReply::bytesAvailable();
+}
+
+void StaticReply::abort()
+{
+	if(isFinished())
+		return;
+	d->data.clear();
+	d->offset = 0;
+	setError(QNetworkReply::OperationCanceledError, tr("Operation canceled"));
+	emit error(QNetworkReply::OperationCanceledError);
+	StaticReplyPrivate::finish(this);
+}
+
+qint64 StaticReply::readData(char *data, qint64 maxSize)
+{
+	if(d->offset >= d->data.size())
+		return isFinished() ? -1 : 0;
+	auto size = qMin<qint64>(maxSize, d->data.size() - d->offset);
+	memcpy(data, d->data.constData() + d->offset, static_cast<size_t>(size));
+	d->offset += size;
+	return size;
+}
+
+// ------------- Private Implementation -------------
+
+StaticReplyPrivate::StaticReplyPrivate(const QByteArray &data) :
+	data(data),
+	offset(0)
+{}
+
+void StaticReplyPrivate::finish(StaticReply *reply)
+{
+	if(reply->isFinished())
+		return;
+	auto size = reply->d->data.size();
+	emit reply->metaDataChanged();
+	if(size > 0) {
+		emit reply->downloadProgress(size, size);
+		emit reply->readyRead();
+	}
+	reply->setFinished(true);
+	emit reply->finished();
+}
@@ -0,0 +1,51 @@
+#ifndef QTRESTCLIENT_STATICREPLY_H
+#define QTRESTCLIENT_STATICREPLY_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <QtCore/qscopedpointer.h>
+#include <QtNetwork/qnetworkreply.h>
+
+namespace QtRestClient {
+
+class StaticReplyPrivate;
+//! A network reply with a fixed status and body, that never touches the network
+class Q_RESTCLIENT_EXPORT StaticReply : public QNetworkReply
+{
+	Q_OBJECT
+	friend class StaticReplyPrivate;
+
+public:
+	//! Creates a reply for the request, that finishes with the given status and data
+	StaticReply(const QNetworkRequest &request, int status, const QByteArray &data, QObject *parent = nullptr);
+	~StaticReply();
+
+	//! @inherit{QNetworkReply::setHeader}
+	using QNetworkReply::setHeader;
+	//! @inherit{QNetworkReply::setRawHeader}
+	using QNetworkReply::setRawHeader;
+	//! @inherit{QNetworkReply::setAttribute}
+	using QNetworkReply::setAttribute;
+	//! @inherit{QNetworkReply::setError}
+	using QNetworkReply::setError;
+
+	//! @inherit{QIODevice::isSequential}
+	bool isSequential() const override;
+	//! @inherit{QIODevice::bytesAvailable}
+	qint64 bytesAvailable() const override;
+
+public Q_SLOTS:
+	//! @inherit{QNetworkReply::abort}
+	void abort() override;
+
+protected:
+	//! @inherit{QIODevice::readData}
+	qint64 readData(char *data, qint64 maxSize) override;
+
+private:
+	QScopedPointer<StaticReplyPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_STATICREPLY_H
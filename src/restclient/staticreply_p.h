@@ -0,0 +1,21 @@
+#ifndef QTRESTCLIENT_STATICREPLY_P_H
+#define QTRESTCLIENT_STATICREPLY_P_H
+
+#include "staticreply.h"
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT StaticReplyPrivate
+{
+public:
+	QByteArray data;
+	qint64 offset;
+
+	StaticReplyPrivate(const QByteArray &data);
+
+	static void finish(StaticReply *reply);
+};
+
+}
+
+#endif // QTRESTCLIENT_STATICREPLY_P_H
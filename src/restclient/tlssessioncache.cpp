@@ -0,0 +1,194 @@
+#include "tlssessioncache.h"
+#include "tlssessioncache_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+using namespace QtRestClient;
+
+TlsSessionCache::TlsSessionCache(QObject *parent) :
+	TlsSessionCache(QString(), parent)
+{}
+
+TlsSessionCache::TlsSessionCache(const QString &storagePath, QObject *parent) :
+	QObject(parent),
+	d(new TlsSessionCachePrivate(storagePath, this))
+{
+	connect(d->saveTimer, &QTimer::timeout,
+			this, &TlsSessionCache::save);
+	if(!d->storagePath.isEmpty())
+		load();
+}
+
+TlsSessionCache::~TlsSessionCache()
+{
+	if(d->saveTimer->isActive())
+		save();
+}
+
+TlsSessionCache *TlsSessionCache::globalInstance()
+{
+	if(!TlsSessionCachePrivate::globalInstance) {
+		auto path = QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+					.absoluteFilePath(QStringLiteral("qtrestclient/tls-sessions"));
+		TlsSessionCachePrivate::globalInstance = new TlsSessionCache(path, qApp);
+	}
+	return TlsSessionCachePrivate::globalInstance;
+}
+
+QString TlsSessionCache::storagePath() const
+{
+	return d->storagePath;
+}
+
+QByteArray TlsSessionCache::sessionTicket(const QString &host, int port) const
+{
+	auto it = d->entries.constFind(TlsSessionCachePrivate::key(host, port));
+	if(it == d->entries.constEnd())
+		return {};
+	if(it->expires.isValid() && it->expires <= QDateTime::currentDateTimeUtc())
+		return {};
+	return it->ticket;
+}
+
+QSslConfiguration TlsSessionCache::prepareConfiguration(QSslConfiguration configuration, const QString &host, int port) const
+{
+	//without session persistence, Qt neither resumes nor reports tickets
+	configuration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+	auto ticket = sessionTicket(host, port);
+	if(!ticket.isEmpty())
+		configuration.setSessionTicket(ticket);
+	return configuration;
+}
+
+void TlsSessionCache::storeSessionTicket(const QString &host, int port, const QByteArray &ticket, int lifetimeHint)
+{
+	if(ticket.isEmpty())
+		return;
+
+	auto &entry = d->entries[TlsSessionCachePrivate::key(host, port)];
+	if(entry.ticket == ticket)
+		return;
+	entry.ticket = ticket;
+	entry.expires = lifetimeHint > 0 ?
+						QDateTime::currentDateTimeUtc().addSecs(lifetimeHint) :
+						QDateTime();
+	if(!d->storagePath.isEmpty())
+		d->saveTimer->start();
+}
+
+void TlsSessionCache::removeSessionTicket(const QString &host, int port)
+{
+	if(d->entries.remove(TlsSessionCachePrivate::key(host, port)) > 0 &&
+	   !d->storagePath.isEmpty())
+		d->saveTimer->start();
+}
+
+void TlsSessionCache::clear()
+{
+	d->entries.clear();
+	if(!d->storagePath.isEmpty())
+		d->saveTimer->start();
+}
+
+bool TlsSessionCache::load()
+{
+	if(d->storagePath.isEmpty())
+		return false;
+
+	QFile file(d->storagePath);
+	if(!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream stream(&file);
+	stream.setVersion(TlsSessionCachePrivate::StreamVersion);
+	quint32 version = 0;
+	stream >> version;
+	if(version != TlsSessionCachePrivate::StorageVersion)
+		return false;
+
+	auto now = QDateTime::currentDateTimeUtc();
+	quint32 count = 0;
+	stream >> count;
+	for(quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+		QString key;
+		TlsSessionCachePrivate::Entry entry;
+		stream >> key >> entry.ticket >> entry.expires;
+		if(entry.expires.isValid() && entry.expires <= now)
+			continue;
+		if(!d->entries.contains(key))
+			d->entries.insert(key, entry);
+	}
+	return stream.status() == QDataStream::Ok;
+}
+
+bool TlsSessionCache::save()
+{
+	d->saveTimer->stop();
+	if(d->storagePath.isEmpty())
+		return false;
+
+	QFileInfo info(d->storagePath);
+	if(!info.dir().mkpath(QStringLiteral(".")))
+		return false;
+
+	QSaveFile file(d->storagePath);
+	if(!file.open(QIODevice::WriteOnly))
+		return false;
+	//tickets allow resuming a session, so noone but the user should be able to read them
+	file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+
+	auto now = QDateTime::currentDateTimeUtc();
+	QDataStream stream(&file);
+	stream.setVersion(TlsSessionCachePrivate::StreamVersion);
+	stream << TlsSessionCachePrivate::StorageVersion;
+	quint32 count = 0;
+	for(auto it = d->entries.constBegin(); it != d->entries.constEnd(); it++) {
+		if(!it->expires.isValid() || it->expires > now)
+			count++;
+	}
+	stream << count;
+	for(auto it = d->entries.constBegin(); it != d->entries.constEnd(); it++) {
+		if(!it->expires.isValid() || it->expires > now)
+			stream << it.key() << it->ticket << it->expires;
+	}
+	return file.commit();
+}
+
+void TlsSessionCache::setStoragePath(QString storagePath)
+{
+	if (d->storagePath == storagePath)
+		return;
+
+	d->storagePath = storagePath;
+	emit storagePathChanged(storagePath, {});
+	if(!d->storagePath.isEmpty()) {
+		load();
+		d->saveTimer->start();
+	}
+}
+
+// ------------- Private Implementation -------------
+
+const quint32 TlsSessionCachePrivate::StorageVersion = 1;
+//the format of QDateTime depends on the stream version, so it must not change with Qt
+const QDataStream::Version TlsSessionCachePrivate::StreamVersion = QDataStream::Qt_5_6;
+QPointer<TlsSessionCache> TlsSessionCachePrivate::globalInstance;
+
+QString TlsSessionCachePrivate::key(const QString &host, int port)
+{
+	return host.toLower() + QLatin1Char(':') + QString::number(port);
+}
+
+TlsSessionCachePrivate::TlsSessionCachePrivate(const QString &storagePath, TlsSessionCache *q_ptr) :
+	storagePath(storagePath),
+	entries(),
+	saveTimer(new QTimer(q_ptr))
+{
+	//collect tickets of concurrent handshakes into a single write
+	saveTimer->setSingleShot(true);
+	saveTimer->setInterval(1000);
+}
@@ -0,0 +1,66 @@
+#ifndef QTRESTCLIENT_TLSSESSIONCACHE_H
+#define QTRESTCLIENT_TLSSESSIONCACHE_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <QtCore/qobject.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtNetwork/qsslconfiguration.h>
+
+namespace QtRestClient {
+
+class TlsSessionCachePrivate;
+//! A persistent cache for TLS session tickets, to resume sessions across clients and restarts
+class Q_RESTCLIENT_EXPORT TlsSessionCache : public QObject
+{
+	Q_OBJECT
+	friend class TlsSessionCachePrivate;
+
+	//! The file the session tickets are persisted to
+	Q_PROPERTY(QString storagePath READ storagePath WRITE setStoragePath NOTIFY storagePathChanged)
+
+public:
+	//! Creates a cache that is only kept in memory
+	explicit TlsSessionCache(QObject *parent = nullptr);
+	//! Creates a cache that is persisted to the given file
+	explicit TlsSessionCache(const QString &storagePath, QObject *parent = nullptr);
+	~TlsSessionCache();
+
+	//! Returns the application wide cache, persisted in the applications cache location
+	static TlsSessionCache *globalInstance();
+
+	//! @readAcFn{TlsSessionCache::storagePath}
+	QString storagePath() const;
+
+	//! Returns the stored session ticket for the given host, if one exists and has not expired
+	QByteArray sessionTicket(const QString &host, int port) const;
+	//! Returns the given configuration, prepared to resume a session with the given host
+	QSslConfiguration prepareConfiguration(QSslConfiguration configuration, const QString &host, int port) const;
+
+public Q_SLOTS:
+	//! Stores a session ticket for the given host
+	void storeSessionTicket(const QString &host, int port, const QByteArray &ticket, int lifetimeHint = -1);
+	//! Removes the session ticket for the given host
+	void removeSessionTicket(const QString &host, int port);
+	//! Removes all session tickets
+	void clear();
+
+	//! Reads the session tickets from the storagePath
+	bool load();
+	//! Writes the session tickets to the storagePath
+	bool save();
+
+	//! @writeAcFn{TlsSessionCache::storagePath}
+	void setStoragePath(QString storagePath);
+
+Q_SIGNALS:
+	//! @notifyAcFn{TlsSessionCache::storagePath}
+	void storagePathChanged(QString storagePath, QPrivateSignal);
+
+private:
+	QScopedPointer<TlsSessionCachePrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_TLSSESSIONCACHE_H
@@ -0,0 +1,39 @@
+#ifndef QTRESTCLIENT_TLSSESSIONCACHE_P_H
+#define QTRESTCLIENT_TLSSESSIONCACHE_P_H
+
+#include "tlssessioncache.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT TlsSessionCachePrivate
+{
+	friend class TlsSessionCache;
+
+public:
+	static const quint32 StorageVersion;
+	static const QDataStream::Version StreamVersion;
+	static QPointer<TlsSessionCache> globalInstance;
+
+	struct Entry {
+		QByteArray ticket;
+		QDateTime expires;
+	};
+
+	QString storagePath;
+	QHash<QString, Entry> entries;
+	QTimer *saveTimer;
+
+	static QString key(const QString &host, int port);
+
+	TlsSessionCachePrivate(const QString &storagePath, TlsSessionCache *q_ptr);
+};
+
+}
+
+#endif // QTRESTCLIENT_TLSSESSIONCACHE_P_H
@@ -0,0 +1,286 @@
+#include "tracer.h"
+#include "tracer_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMetaEnum>
+#include <QtCore/QUuid>
+using namespace QtRestClient;
+
+const QByteArray Tracer::TraceParentHeader("traceparent");
+const QByteArray Tracer::TraceStateHeader("tracestate");
+
+Tracer::Tracer(QObject *parent) :
+	QObject(parent),
+	d(new TracerPrivate(this))
+{
+	connect(d->flushTimer, &QTimer::timeout,
+			this, &Tracer::flush);
+}
+
+Tracer::~Tracer()
+{
+	flush();
+}
+
+QString Tracer::serviceName() const
+{
+	return d->serviceName;
+}
+
+bool Tracer::isSampled() const
+{
+	return d->sampled;
+}
+
+QString Tracer::exportFile() const
+{
+	return d->exportFile;
+}
+
+QByteArray Tracer::parentContext() const
+{
+	return d->parentContext;
+}
+
+QByteArray Tracer::traceState() const
+{
+	return d->traceState;
+}
+
+QByteArray Tracer::createTraceParent() const
+{
+	if(isValidTraceParent(d->parentContext))
+		return TracerPrivate::respan(d->parentContext);
+	else {
+		return TracerPrivate::TraceParentVersion + '-' +
+				TracerPrivate::randomId(16) + '-' +
+				TracerPrivate::randomId(8) + '-' +
+				(d->sampled ? "01" : "00");
+	}
+}
+
+bool Tracer::isValidTraceParent(const QByteArray &traceParent)
+{
+	//version-traceid-spanid-flags, with non zero ids
+	auto parts = traceParent.split('-');
+	if(parts.size() < 4 ||
+	   parts[0].size() != 2 || parts[0] == "ff" ||
+	   parts[1].size() != 32 || parts[2].size() != 16 || parts[3].size() != 2)
+		return false;
+	for(auto i = 0; i < 4; i++) {
+		for(auto c : parts[i]) {
+			if(!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')))
+				return false;
+		}
+	}
+	return parts[1] != QByteArray(32, '0') &&
+			parts[2] != QByteArray(16, '0');
+}
+
+void Tracer::setParentContext(const QByteArray &traceParent, const QByteArray &traceState)
+{
+	if(isValidTraceParent(traceParent)) {
+		d->parentContext = traceParent;
+		d->traceState = traceState;
+	} else
+		clearParentContext();
+}
+
+void Tracer::clearParentContext()
+{
+	d->parentContext.clear();
+	d->traceState.clear();
+}
+
+void Tracer::recordRequest(const RequestMetrics &metrics)
+{
+	auto traceParent = metrics.traceParent();
+	if(!isValidTraceParent(traceParent))
+		return;
+	auto parts = traceParent.split('-');
+	//only sampled spans are recorded, just like the server does
+	if((parts[3].toInt(nullptr, 16) & 0x01) == 0)
+		return;
+
+	auto endTime = QDateTime::currentMSecsSinceEpoch() * Q_INT64_C(1000000);
+	auto duration = qMax<qint64>(metrics.timestamp(RequestMetrics::HandlerDone), 0);
+	auto startTime = endTime - duration;
+
+	QJsonArray events;
+	auto phaseEnum = QMetaEnum::fromType<RequestMetrics::Phase>();
+	for(auto i = 0; i < phaseEnum.keyCount(); i++) {
+		auto phase = static_cast<RequestMetrics::Phase>(phaseEnum.value(i));
+		if(phase == RequestMetrics::Created || !metrics.hasPhase(phase))
+			continue;
+		events.append(QJsonObject {
+						  {QStringLiteral("timeUnixNano"), QString::number(startTime + metrics.timestamp(phase))},
+						  {QStringLiteral("name"), QString::fromLatin1(phaseEnum.key(i))}
+					  });
+	}
+
+	QJsonArray attributes;
+	attributes.append(TracerPrivate::stringAttribute(QStringLiteral("http.method"), QString::fromLatin1(metrics.verb())));
+	attributes.append(TracerPrivate::stringAttribute(QStringLiteral("http.url"), metrics.url().toString(QUrl::RemoveUserInfo)));
+	if(!metrics.route().isEmpty())
+		attributes.append(TracerPrivate::stringAttribute(QStringLiteral("http.route"), metrics.route()));
+	if(metrics.status() > 0)
+		attributes.append(TracerPrivate::intAttribute(QStringLiteral("http.status_code"), metrics.status()));
+	attributes.append(TracerPrivate::stringAttribute(QStringLiteral("http.flavor"),
+													 metrics.protocol() == TransportProfile::Http1 ?
+														 QStringLiteral("1.1") :
+														 QStringLiteral("2.0")));
+	attributes.append(TracerPrivate::intAttribute(QStringLiteral("http.request_content_length"), metrics.bytesSent()));
+	attributes.append(TracerPrivate::intAttribute(QStringLiteral("http.response_content_length"), metrics.bytesReceived()));
+	if(metrics.retryCount() > 0)
+		attributes.append(TracerPrivate::intAttribute(QStringLiteral("http.resend_count"), metrics.retryCount()));
+
+	QJsonObject status;
+	if(metrics.networkError() != 0 || metrics.status() >= 400)
+		status[QStringLiteral("code")] = 2;//STATUS_CODE_ERROR
+
+	QJsonObject span {
+		{QStringLiteral("traceId"), QString::fromLatin1(parts[1])},
+		{QStringLiteral("spanId"), QString::fromLatin1(parts[2])},
+		{QStringLiteral("name"), metrics.route().isEmpty() ?
+			 QString::fromLatin1(metrics.verb()) :
+			 QString::fromLatin1(metrics.verb()) + QLatin1Char(' ') + metrics.route()},
+		{QStringLiteral("kind"), 3},//SPAN_KIND_CLIENT
+		{QStringLiteral("startTimeUnixNano"), QString::number(startTime)},
+		{QStringLiteral("endTimeUnixNano"), QString::number(endTime)},
+		{QStringLiteral("attributes"), attributes},
+		{QStringLiteral("events"), events},
+		{QStringLiteral("status"), status}
+	};
+	if(!metrics.parentSpanId().isEmpty())
+		span[QStringLiteral("parentSpanId")] = QString::fromLatin1(metrics.parentSpanId());
+
+	emit spanFinished(span, {});
+	if(!d->exportFile.isEmpty()) {
+		d->pendingSpans.append(span);
+		if(!d->flushTimer->isActive())
+			d->flushTimer->start();
+	}
+}
+
+bool Tracer::flush()
+{
+	d->flushTimer->stop();
+	if(d->pendingSpans.isEmpty() || d->exportFile.isEmpty())
+		return true;
+
+	QJsonObject resource {
+		{QStringLiteral("attributes"), QJsonArray {
+			 TracerPrivate::stringAttribute(QStringLiteral("service.name"), d->serviceName)
+		 }}
+	};
+	QJsonObject scopeSpans {
+		{QStringLiteral("scope"), QJsonObject {
+			 {QStringLiteral("name"), QStringLiteral("QtRestClient")}
+		 }},
+		{QStringLiteral("spans"), d->pendingSpans}
+	};
+	QJsonObject exportRequest {
+		{QStringLiteral("resourceSpans"), QJsonArray {
+			 QJsonObject {
+				 {QStringLiteral("resource"), resource},
+				 {QStringLiteral("scopeSpans"), QJsonArray {scopeSpans}}
+			 }
+		 }}
+	};
+
+	//one export request per line, as the OTLP file exporter does
+	QFile file(d->exportFile);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Append))
+		return false;
+	auto line = QJsonDocument(exportRequest).toJson(QJsonDocument::Compact) + '\n';
+	if(file.write(line) != line.size())
+		return false;
+	d->pendingSpans = QJsonArray();
+	return true;
+}
+
+void Tracer::setServiceName(QString serviceName)
+{
+	if (d->serviceName == serviceName)
+		return;
+
+	flush();
+	d->serviceName = serviceName;
+	emit serviceNameChanged(serviceName, {});
+}
+
+void Tracer::setSampled(bool sampled)
+{
+	if (d->sampled == sampled)
+		return;
+
+	d->sampled = sampled;
+	emit sampledChanged(sampled, {});
+}
+
+void Tracer::setExportFile(QString exportFile)
+{
+	if (d->exportFile == exportFile)
+		return;
+
+	flush();
+	d->exportFile = exportFile;
+	emit exportFileChanged(exportFile, {});
+}
+
+// ------------- Private Implementation -------------
+
+const QByteArray TracerPrivate::TraceParentVersion("00");
+
+TracerPrivate::TracerPrivate(Tracer *q_ptr) :
+	serviceName(QCoreApplication::applicationName()),
+	sampled(true),
+	exportFile(),
+	parentContext(),
+	traceState(),
+	pendingSpans(),
+	flushTimer(new QTimer(q_ptr))
+{
+	flushTimer->setSingleShot(true);
+	flushTimer->setInterval(1000);
+}
+
+QByteArray TracerPrivate::randomId(int size)
+{
+	QByteArray id;
+	while(id.size() < size)
+		id += QUuid::createUuid().toRfc4122();
+	return id.left(size).toHex();
+}
+
+QByteArray TracerPrivate::respan(const QByteArray &traceParent)
+{
+	auto parts = traceParent.split('-');
+	parts[0] = TraceParentVersion;
+	parts[2] = randomId(8);
+	return parts.mid(0, 4).join('-');
+}
+
+QJsonObject TracerPrivate::stringAttribute(const QString &key, const QString &value)
+{
+	return {
+		{QStringLiteral("key"), key},
+		{QStringLiteral("value"), QJsonObject {
+			 {QStringLiteral("stringValue"), value}
+		 }}
+	};
+}
+
+QJsonObject TracerPrivate::intAttribute(const QString &key, qint64 value)
+{
+	//OTLP JSON encodes 64 bit integers as strings
+	return {
+		{QStringLiteral("key"), key},
+		{QStringLiteral("value"), QJsonObject {
+			 {QStringLiteral("intValue"), QString::number(value)}
+		 }}
+	};
+}
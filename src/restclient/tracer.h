@@ -0,0 +1,89 @@
+#ifndef QTRESTCLIENT_TRACER_H
+#define QTRESTCLIENT_TRACER_H
+
+#include "QtRestClient/qtrestclient_global.h"
+#include "QtRestClient/requestmetrics.h"
+
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qscopedpointer.h>
+
+namespace QtRestClient {
+
+class TracerPrivate;
+//! A class to propagate W3C trace context with requests and export a span for each of them
+class Q_RESTCLIENT_EXPORT Tracer : public QObject
+{
+	Q_OBJECT
+	friend class TracerPrivate;
+
+	//! The name of the service the spans are exported for
+	Q_PROPERTY(QString serviceName READ serviceName WRITE setServiceName NOTIFY serviceNameChanged)
+	//! Specifies, whether new traces are sampled, i.e. recorded by the backends
+	Q_PROPERTY(bool sampled READ isSampled WRITE setSampled NOTIFY sampledChanged)
+	//! The file the spans are appended to, as OTLP JSON lines
+	Q_PROPERTY(QString exportFile READ exportFile WRITE setExportFile NOTIFY exportFileChanged)
+
+public:
+	//! The name of the trace context header
+	static const QByteArray TraceParentHeader;
+	//! The name of the vendor specific trace state header
+	static const QByteArray TraceStateHeader;
+
+	//! Constructor
+	explicit Tracer(QObject *parent = nullptr);
+	~Tracer();
+
+	//! @readAcFn{Tracer::serviceName}
+	QString serviceName() const;
+	//! @readAcFn{Tracer::sampled}
+	bool isSampled() const;
+	//! @readAcFn{Tracer::exportFile}
+	QString exportFile() const;
+
+	//! Returns the traceparent of the span new requests are children of, if any
+	QByteArray parentContext() const;
+	//! Returns the tracestate that is sent with every request
+	QByteArray traceState() const;
+
+	//! Creates a traceparent for a new client span, as child of the parentContext
+	QByteArray createTraceParent() const;
+	//! Checks, whether the given value is a valid W3C traceparent
+	static bool isValidTraceParent(const QByteArray &traceParent);
+
+public Q_SLOTS:
+	//! Sets the span new requests are children of, typically from an incoming request
+	void setParentContext(const QByteArray &traceParent, const QByteArray &traceState = QByteArray());
+	//! Removes the parent context, so every request starts a new trace
+	void clearParentContext();
+
+	//! Creates and exports the span of a completed request
+	void recordRequest(const QtRestClient::RequestMetrics &metrics);
+	//! Writes all pending spans to the exportFile
+	bool flush();
+
+	//! @writeAcFn{Tracer::serviceName}
+	void setServiceName(QString serviceName);
+	//! @writeAcFn{Tracer::sampled}
+	void setSampled(bool sampled);
+	//! @writeAcFn{Tracer::exportFile}
+	void setExportFile(QString exportFile);
+
+Q_SIGNALS:
+	//! Is emitted for every span that has been recorded, in OTLP JSON form
+	void spanFinished(const QJsonObject &span, QPrivateSignal);
+
+	//! @notifyAcFn{Tracer::serviceName}
+	void serviceNameChanged(QString serviceName, QPrivateSignal);
+	//! @notifyAcFn{Tracer::sampled}
+	void sampledChanged(bool sampled, QPrivateSignal);
+	//! @notifyAcFn{Tracer::exportFile}
+	void exportFileChanged(QString exportFile, QPrivateSignal);
+
+private:
+	QScopedPointer<TracerPrivate> d;
+};
+
+}
+
+#endif // QTRESTCLIENT_TRACER_H
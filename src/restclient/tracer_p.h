@@ -0,0 +1,37 @@
+#ifndef QTRESTCLIENT_TRACER_P_H
+#define QTRESTCLIENT_TRACER_P_H
+
+#include "tracer.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QTimer>
+
+namespace QtRestClient {
+
+class Q_RESTCLIENT_EXPORT TracerPrivate
+{
+	friend class Tracer;
+
+public:
+	static const QByteArray TraceParentVersion;
+
+	QString serviceName;
+	bool sampled;
+	QString exportFile;
+	QByteArray parentContext;
+	QByteArray traceState;
+
+	QJsonArray pendingSpans;
+	QTimer *flushTimer;
+
+	TracerPrivate(Tracer *q_ptr);
+
+	static QByteArray randomId(int size);
+	static QByteArray respan(const QByteArray &traceParent);
+	static QJsonObject stringAttribute(const QString &key, const QString &value);
+	static QJsonObject intAttribute(const QString &key, qint64 value);
+};
+
+}
+
+#endif // QTRESTCLIENT_TRACER_P_H
@@ -0,0 +1,215 @@
+#include "transportprofile.h"
+using namespace QtRestClient;
+
+namespace QtRestClient {
+struct TransportProfilePrivate : public QSharedData
+{
+	TransportProfile::Protocol protocol;
+	bool pipelining;
+	int maxConcurrentStreams;
+	int sessionReceiveWindowSize;
+	int streamReceiveWindowSize;
+	int maxFrameSize;
+	bool serverPush;
+	bool huffmanCompression;
+
+	inline TransportProfilePrivate(TransportProfile::Protocol protocol = TransportProfile::Http1) :
+		QSharedData(),
+		protocol(protocol),
+		pipelining(false),
+		maxConcurrentStreams(-1),
+		sessionReceiveWindowSize(-1),
+		streamReceiveWindowSize(-1),
+		maxFrameSize(-1),
+		serverPush(false),
+		huffmanCompression(true)
+	{}
+
+	inline TransportProfilePrivate(const TransportProfilePrivate &other) :
+		QSharedData(other),
+		protocol(other.protocol),
+		pipelining(other.pipelining),
+		maxConcurrentStreams(other.maxConcurrentStreams),
+		sessionReceiveWindowSize(other.sessionReceiveWindowSize),
+		streamReceiveWindowSize(other.streamReceiveWindowSize),
+		maxFrameSize(other.maxFrameSize),
+		serverPush(other.serverPush),
+		huffmanCompression(other.huffmanCompression)
+	{}
+};
+}
+
+TransportProfile::TransportProfile(Protocol protocol) :
+	d(new TransportProfilePrivate(protocol))
+{}
+
+TransportProfile::TransportProfile(const TransportProfile &other) :
+	d(other.d)
+{}
+
+TransportProfile::~TransportProfile() {}
+
+TransportProfile TransportProfile::bulkTransfer()
+{
+	//the Qt defaults are tuned for small responses, so allow more data in flight
+	return TransportProfile(Http2)
+			.setPipelining(true)
+			.setSessionReceiveWindowSize(16 * 1024 * 1024)
+			.setStreamReceiveWindowSize(4 * 1024 * 1024)
+			.setMaxFrameSize(64 * 1024);
+}
+
+TransportProfile::Protocol TransportProfile::protocol() const
+{
+	return d->protocol;
+}
+
+bool TransportProfile::pipelining() const
+{
+	return d->pipelining;
+}
+
+int TransportProfile::maxConcurrentStreams() const
+{
+	return d->maxConcurrentStreams;
+}
+
+int TransportProfile::sessionReceiveWindowSize() const
+{
+	return d->sessionReceiveWindowSize;
+}
+
+int TransportProfile::streamReceiveWindowSize() const
+{
+	return d->streamReceiveWindowSize;
+}
+
+int TransportProfile::maxFrameSize() const
+{
+	return d->maxFrameSize;
+}
+
+bool TransportProfile::serverPush() const
+{
+	return d->serverPush;
+}
+
+bool TransportProfile::huffmanCompression() const
+{
+	return d->huffmanCompression;
+}
+
+TransportProfile &TransportProfile::setProtocol(Protocol protocol)
+{
+	d->protocol = protocol;
+	return *this;
+}
+
+TransportProfile &TransportProfile::setPipelining(bool pipelining)
+{
+	d->pipelining = pipelining;
+	return *this;
+}
+
+TransportProfile &TransportProfile::setMaxConcurrentStreams(int maxConcurrentStreams)
+{
+	d->maxConcurrentStreams = maxConcurrentStreams;
+	return *this;
+}
+
+TransportProfile &TransportProfile::setSessionReceiveWindowSize(int sessionReceiveWindowSize)
+{
+	d->sessionReceiveWindowSize = sessionReceiveWindowSize;
+	return *this;
+}
+
+TransportProfile &TransportProfile::setStreamReceiveWindowSize(int streamReceiveWindowSize)
+{
+	d->streamReceiveWindowSize = streamReceiveWindowSize;
+	return *this;
+}
+
+TransportProfile &TransportProfile::setMaxFrameSize(int maxFrameSize)
+{
+	d->maxFrameSize = maxFrameSize;
+	return *this;
+}
+
+TransportProfile &TransportProfile::setServerPush(bool serverPush)
+{
+	d->serverPush = serverPush;
+	return *this;
+}
+
+TransportProfile &TransportProfile::setHuffmanCompression(bool huffmanCompression)
+{
+	d->huffmanCompression = huffmanCompression;
+	return *this;
+}
+
+QHash<QNetworkRequest::Attribute, QVariant> TransportProfile::attributes() const
+{
+	QHash<QNetworkRequest::Attribute, QVariant> attribs;
+	attribs.insert(QNetworkRequest::HttpPipeliningAllowedAttribute, d->pipelining);
+	attribs.insert(QNetworkRequest::HTTP2AllowedAttribute, d->protocol != Http1);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+	attribs.insert(QNetworkRequest::Http2DirectAttribute, d->protocol == Http2PriorKnowledge);
+#endif
+	return attribs;
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+QHttp2Configuration TransportProfile::http2Configuration() const
+{
+	//start with the settings Qt tuned for it's own requests
+	auto config = QNetworkRequest().http2Configuration();
+	config.setServerPushEnabled(d->serverPush);
+	config.setHuffmanCompressionEnabled(d->huffmanCompression);
+	if(d->sessionReceiveWindowSize > 0)
+		config.setSessionReceiveWindowSize(static_cast<unsigned>(d->sessionReceiveWindowSize));
+	if(d->streamReceiveWindowSize > 0)
+		config.setStreamReceiveWindowSize(static_cast<unsigned>(d->streamReceiveWindowSize));
+	if(d->maxFrameSize > 0)
+		config.setMaxFrameSize(static_cast<unsigned>(d->maxFrameSize));
+#if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
+	if(d->maxConcurrentStreams > 0)
+		config.setMaxConcurrentStreams(static_cast<unsigned>(d->maxConcurrentStreams));
+#endif
+	return config;
+}
+#endif
+
+TransportProfile::Protocol TransportProfile::usedProtocol(const QNetworkReply *reply)
+{
+	if(!reply || !reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool())
+		return Http1;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+	if(reply->request().attribute(QNetworkRequest::Http2DirectAttribute, false).toBool())
+		return Http2PriorKnowledge;
+#endif
+	return Http2;
+}
+
+TransportProfile &TransportProfile::operator=(const TransportProfile &other)
+{
+	d = other.d;
+	return *this;
+}
+
+bool TransportProfile::operator==(const TransportProfile &other) const
+{
+	return d == other.d || (
+		d->protocol == other.d->protocol &&
+		d->pipelining == other.d->pipelining &&
+		d->maxConcurrentStreams == other.d->maxConcurrentStreams &&
+		d->sessionReceiveWindowSize == other.d->sessionReceiveWindowSize &&
+		d->streamReceiveWindowSize == other.d->streamReceiveWindowSize &&
+		d->maxFrameSize == other.d->maxFrameSize &&
+		d->serverPush == other.d->serverPush &&
+		d->huffmanCompression == other.d->huffmanCompression);
+}
+
+bool TransportProfile::operator!=(const TransportProfile &other) const
+{
+	return !operator==(other);
+}
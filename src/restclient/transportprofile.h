@@ -0,0 +1,116 @@
+#ifndef QTRESTCLIENT_TRANSPORTPROFILE_H
+#define QTRESTCLIENT_TRANSPORTPROFILE_H
+
+#include "QtRestClient/qtrestclient_global.h"
+
+#include <QtCore/qobject.h>
+#include <QtCore/qshareddata.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtNetwork/qnetworkrequest.h>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+#include <QtNetwork/qhttp2configuration.h>
+#endif
+
+namespace QtRestClient {
+
+struct TransportProfilePrivate;
+//! Describes the HTTP protocol and connection settings used by a RestClient
+class Q_RESTCLIENT_EXPORT TransportProfile
+{
+	Q_GADGET
+
+	//! The HTTP protocol to be used for requests
+	Q_PROPERTY(Protocol protocol READ protocol WRITE setProtocol)
+	//! Specifies, whether HTTP/1.1 pipelining is allowed
+	Q_PROPERTY(bool pipelining READ pipelining WRITE setPipelining)
+	//! The maximum number of concurrent HTTP/2 streams per connection, or -1 for the server limit
+	Q_PROPERTY(int maxConcurrentStreams READ maxConcurrentStreams WRITE setMaxConcurrentStreams)
+	//! The HTTP/2 receive window of the whole connection, or -1 for the default
+	Q_PROPERTY(int sessionReceiveWindowSize READ sessionReceiveWindowSize WRITE setSessionReceiveWindowSize)
+	//! The HTTP/2 receive window of every single stream, or -1 for the default
+	Q_PROPERTY(int streamReceiveWindowSize READ streamReceiveWindowSize WRITE setStreamReceiveWindowSize)
+	//! The maximum HTTP/2 frame size the client accepts, or -1 for the default
+	Q_PROPERTY(int maxFrameSize READ maxFrameSize WRITE setMaxFrameSize)
+	//! Specifies, whether the server may push resources over HTTP/2
+	Q_PROPERTY(bool serverPush READ serverPush WRITE setServerPush)
+	//! Specifies, whether HPACK huffman compression is used for HTTP/2 headers
+	Q_PROPERTY(bool huffmanCompression READ huffmanCompression WRITE setHuffmanCompression)
+
+public:
+	//! The HTTP protocols a request can be made with
+	enum Protocol {
+		Http1,//!< HTTP/1.1 only
+		Http2,//!< HTTP/2 if the server supports it, negotiated via ALPN
+		Http2PriorKnowledge//!< HTTP/2 without negotiation, for cleartext `h2c` to known servers
+	};
+	Q_ENUM(Protocol)
+
+	//! Creates a profile for the given protocol, with default settings
+	TransportProfile(Protocol protocol = Http1);
+	//! Copy Constructor
+	TransportProfile(const TransportProfile &other);
+	~TransportProfile();
+
+	//! Returns a profile to use HTTP/2 where possible, with large receive windows for bulk transfers
+	static TransportProfile bulkTransfer();
+
+	//! @readAcFn{TransportProfile::protocol}
+	Protocol protocol() const;
+	//! @readAcFn{TransportProfile::pipelining}
+	bool pipelining() const;
+	//! @readAcFn{TransportProfile::maxConcurrentStreams}
+	int maxConcurrentStreams() const;
+	//! @readAcFn{TransportProfile::sessionReceiveWindowSize}
+	int sessionReceiveWindowSize() const;
+	//! @readAcFn{TransportProfile::streamReceiveWindowSize}
+	int streamReceiveWindowSize() const;
+	//! @readAcFn{TransportProfile::maxFrameSize}
+	int maxFrameSize() const;
+	//! @readAcFn{TransportProfile::serverPush}
+	bool serverPush() const;
+	//! @readAcFn{TransportProfile::huffmanCompression}
+	bool huffmanCompression() const;
+
+	//! @writeAcFn{TransportProfile::protocol}
+	TransportProfile &setProtocol(Protocol protocol);
+	//! @writeAcFn{TransportProfile::pipelining}
+	TransportProfile &setPipelining(bool pipelining);
+	//! @writeAcFn{TransportProfile::maxConcurrentStreams}
+	TransportProfile &setMaxConcurrentStreams(int maxConcurrentStreams);
+	//! @writeAcFn{TransportProfile::sessionReceiveWindowSize}
+	TransportProfile &setSessionReceiveWindowSize(int sessionReceiveWindowSize);
+	//! @writeAcFn{TransportProfile::streamReceiveWindowSize}
+	TransportProfile &setStreamReceiveWindowSize(int streamReceiveWindowSize);
+	//! @writeAcFn{TransportProfile::maxFrameSize}
+	TransportProfile &setMaxFrameSize(int maxFrameSize);
+	//! @writeAcFn{TransportProfile::serverPush}
+	TransportProfile &setServerPush(bool serverPush);
+	//! @writeAcFn{TransportProfile::huffmanCompression}
+	TransportProfile &setHuffmanCompression(bool huffmanCompression);
+
+	//! Returns the request attributes needed for this profile
+	QHash<QNetworkRequest::Attribute, QVariant> attributes() const;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	//! Returns the HTTP/2 configuration for this profile
+	QHttp2Configuration http2Configuration() const;
+#endif
+
+	//! Returns the protocol the given reply was actually transferred with
+	static Protocol usedProtocol(const QNetworkReply *reply);
+
+	//! Assignment operator
+	TransportProfile &operator=(const TransportProfile &other);
+	//! Equality operator
+	bool operator==(const TransportProfile &other) const;
+	//! Inequality operator
+	bool operator!=(const TransportProfile &other) const;
+
+private:
+	QSharedDataPointer<TransportProfilePrivate> d;
+};
+
+}
+
+Q_DECLARE_METATYPE(QtRestClient::TransportProfile)
+
+#endif // QTRESTCLIENT_TRANSPORTPROFILE_H
@@ -0,0 +1,14 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_awaitable
+CONFIG   += console c++2a
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+include(../tests.pri)
+
+SOURCES += tst_awaitable.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
@@ -0,0 +1,234 @@
+#include "testlib.h"
+
+#ifdef QTRESTCLIENT_HAS_COROUTINES
+namespace {
+
+struct Outcome
+{
+	bool done = false;
+	QJsonValue value;
+	bool excepted = false;
+	QtRestClient::RestReply::ErrorType errorType = QtRestClient::RestReply::NetworkError;
+	int error = 0;
+};
+
+QtRestClient::Task<> awaitJson(QtRestClient::RestReply *reply, Outcome *outcome)
+{
+	try {
+		outcome->value = co_await reply;
+	} catch(QtRestClient::RestReplyException &e) {
+		outcome->excepted = true;
+		outcome->errorType = e.errorType();
+		outcome->error = e.error();
+	}
+	outcome->done = true;
+}
+
+QtRestClient::Task<int> awaitPostId(QtRestClient::GenericRestReply<JphPost*> *reply)
+{
+	auto post = co_await reply;
+	auto id = post->id;
+	post->deleteLater();
+	co_return id;
+}
+
+QtRestClient::Task<> sumPostIds(QtRestClient::RestClass *restClass, int *sum)
+{
+	//wrap all replies before awaiting, as they may complete in the meantime
+	auto first = QtRestClient::awaitReply(restClass->get(QStringLiteral("1")));
+	auto second = QtRestClient::awaitReply(restClass->get(QStringLiteral("2")));
+	auto firstValue = co_await first;
+	auto secondValue = co_await second;
+	*sum = firstValue.toObject()[QStringLiteral("id")].toInt() +
+		   secondValue.toObject()[QStringLiteral("id")].toInt();
+}
+
+QtRestClient::Task<> awaitTask(QtRestClient::GenericRestReply<JphPost*> *reply, Outcome *outcome)
+{
+	try {
+		outcome->value = co_await awaitPostId(reply);
+	} catch(QtRestClient::RestReplyException &e) {
+		outcome->excepted = true;
+		outcome->errorType = e.errorType();
+		outcome->error = e.error();
+	}
+	outcome->done = true;
+}
+
+}
+#endif
+
+class AwaitableTest : public QObject
+{
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+
+	void testAwaitReply_data();
+	void testAwaitReply();
+	void testAwaitGenericReply();
+	void testAwaitDestroyedReply();
+	void testNestedTasks();
+	void testDetachedTask();
+
+private:
+	HttpServer *server;
+	QtRestClient::RestClient *client;
+};
+
+void AwaitableTest::initTestCase()
+{
+#ifdef Q_OS_LINUX
+	if(!qgetenv("LD_PRELOAD").contains("Qt5RestClient"))
+		qWarning() << "No LD_PRELOAD set - this may fail on systems with multiple version of the modules";
+#endif
+	server = new HttpServer(this);
+	server->verifyRunning();
+	server->setDefaultData();
+	client = Testlib::createClient(this);
+	client->setBaseUrl(QStringLiteral("http://localhost:%1").arg(server->serverPort()));
+}
+
+void AwaitableTest::cleanupTestCase()
+{
+	server->deleteLater();
+	server = nullptr;
+	client->deleteLater();
+	client = nullptr;
+}
+
+void AwaitableTest::testAwaitReply_data()
+{
+	QTest::addColumn<QUrl>("url");
+	QTest::addColumn<bool>("except");
+	QTest::addColumn<QtRestClient::RestReply::ErrorType>("errorType");
+	QTest::addColumn<int>("error");
+
+	QTest::newRow("succeeded") << server->url("posts/1")
+							   << false
+							   << QtRestClient::RestReply::NetworkError
+							   << 0;
+	QTest::newRow("failed") << server->url("posts/baum")
+							<< true
+							<< QtRestClient::RestReply::FailureError
+							<< 404;
+	QTest::newRow("error") << QUrl(QStringLiteral("http://localhost:1/posts/1"))
+						   << true
+						   << QtRestClient::RestReply::NetworkError
+						   << static_cast<int>(QNetworkReply::ConnectionRefusedError);
+}
+
+void AwaitableTest::testAwaitReply()
+{
+#ifdef QTRESTCLIENT_HAS_COROUTINES
+	QFETCH(QUrl, url);
+	QFETCH(bool, except);
+	QFETCH(QtRestClient::RestReply::ErrorType, errorType);
+	QFETCH(int, error);
+
+	Outcome outcome;
+	auto reply = new QtRestClient::RestReply(client->manager()->get(QNetworkRequest(url)));
+	auto task = awaitJson(reply, &outcome);
+	QVERIFY(!task.isFinished());
+	QTRY_VERIFY_WITH_TIMEOUT(task.isFinished(), 5000);
+	QVERIFY(outcome.done);
+	QCOMPARE(outcome.excepted, except);
+	if(except) {
+		QCOMPARE(outcome.errorType, errorType);
+		QCOMPARE(outcome.error, error);
+	} else
+		QCOMPARE(outcome.value.toObject()[QStringLiteral("id")].toInt(), 1);
+#else
+	QSKIP("The compiler does not support coroutines");
+#endif
+}
+
+void AwaitableTest::testAwaitGenericReply()
+{
+#ifdef QTRESTCLIENT_HAS_COROUTINES
+	auto postClass = client->createClass(QStringLiteral("posts"), this);
+
+	Outcome outcome;
+	auto task = awaitTask(postClass->get<JphPost*>(QStringLiteral("1")), &outcome);
+	QTRY_VERIFY_WITH_TIMEOUT(task.isFinished(), 5000);
+	QVERIFY(!outcome.excepted);
+	QCOMPARE(outcome.value.toInt(), 1);
+
+	//a list can't be deserialized as post, and the handlers of the reply still see that
+	Outcome failedOutcome;
+	auto handled = false;
+	auto failedReply = client->rootClass()->get<JphPost*>(QStringLiteral("posts"));
+	failedReply->onSerializeException([&](QJsonSerializerException &){
+		handled = true;
+	});
+	auto failedTask = awaitTask(failedReply, &failedOutcome);
+	QTRY_VERIFY_WITH_TIMEOUT(failedTask.isFinished(), 5000);
+	QVERIFY(failedOutcome.excepted);
+	QCOMPARE(failedOutcome.errorType, QtRestClient::RestReply::DeserializationError);
+	QVERIFY(handled);
+
+	postClass->deleteLater();
+#else
+	QSKIP("The compiler does not support coroutines");
+#endif
+}
+
+void AwaitableTest::testAwaitDestroyedReply()
+{
+#ifdef QTRESTCLIENT_HAS_COROUTINES
+	Outcome outcome;
+	auto reply = client->rootClass()->get(QStringLiteral("posts/1"));
+	auto task = awaitJson(reply, &outcome);
+	QVERIFY(!task.isFinished());
+
+	//the coroutine is resumed instead of waiting forever
+	delete reply;
+	QVERIFY(task.isFinished());
+	QVERIFY(outcome.excepted);
+	QCOMPARE(outcome.errorType, QtRestClient::RestReply::NetworkError);
+	QCOMPARE(outcome.error, static_cast<int>(QNetworkReply::OperationCanceledError));
+#else
+	QSKIP("The compiler does not support coroutines");
+#endif
+}
+
+void AwaitableTest::testNestedTasks()
+{
+#ifdef QTRESTCLIENT_HAS_COROUTINES
+	auto postClass = client->createClass(QStringLiteral("posts"), this);
+
+	auto sum = 0;
+	auto task = sumPostIds(postClass, &sum);
+	QTRY_VERIFY_WITH_TIMEOUT(task.isFinished(), 5000);
+	QCOMPARE(sum, 3);
+
+	postClass->deleteLater();
+#else
+	QSKIP("The compiler does not support coroutines");
+#endif
+}
+
+void AwaitableTest::testDetachedTask()
+{
+#ifdef QTRESTCLIENT_HAS_COROUTINES
+	Outcome outcome;
+	{
+		auto task = awaitJson(client->rootClass()->get(QStringLiteral("posts/2")), &outcome);
+		QVERIFY(!task.isFinished());
+	}
+
+	//the coroutine continues after its task was destroyed
+	QVERIFY(!outcome.done);
+	QTRY_VERIFY_WITH_TIMEOUT(outcome.done, 5000);
+	QVERIFY(!outcome.excepted);
+	QCOMPARE(outcome.value.toObject()[QStringLiteral("id")].toInt(), 2);
+#else
+	QSKIP("The compiler does not support coroutines");
+#endif
+}
+
+QTEST_MAIN(AwaitableTest)
+
+#include "tst_awaitable.moc"
@@ -1,5 +1,13 @@
 #include "testlib.h"
 
+class SequentialBuffer : public QBuffer
+{
+public:
+	bool isSequential() const override {
+		return true;
+	}
+};
+
 class RequestBuilderTest : public QObject
 {
 	Q_OBJECT
@@ -17,6 +25,13 @@ private Q_SLOTS:
 	void testSending_data();
 	void testSending();
 
+	void testSigning();
+	void testBodyDevice();
+	void testMultiPart();
+
+	void testParallelDownload_data();
+	void testParallelDownload();
+
 private:
 	HttpServer *server;
 	QNetworkAccessManager *nam;
@@ -405,6 +420,187 @@ void RequestBuilderTest::testSending()
 	reply->deleteLater();
 }
 
+void RequestBuilderTest::testSigning()
+{
+	QtRestClient::RequestSigner signer(QStringLiteral("AKIDEXAMPLE"),
+									   QStringLiteral("wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"),
+									   QStringLiteral("us-east-1"),
+									   QStringLiteral("service"));
+	auto timestamp = QDateTime(QDate(2015, 8, 30), QTime(12, 36), Qt::UTC);
+	auto builder = QtRestClient::RequestBuilder(QUrl(QStringLiteral("https://example.amazonaws.com")))
+				   .addPath(QStringLiteral("items"))
+				   .addParameter(QStringLiteral("b"), QStringLiteral("2"))
+				   .addParameter(QStringLiteral("a"), QStringLiteral("1 2"))
+				   .setVerb("POST");
+
+	auto dataBuilder = builder;
+	dataBuilder.setBody(QByteArray("{\"id\":1}"), "application/json");
+	signer.sign(dataBuilder, timestamp);
+	auto request = dataBuilder.build();
+	QCOMPARE(request.rawHeader(QtRestClient::RequestSigner::DateHeader), QByteArray("20150830T123600Z"));
+	QCOMPARE(request.rawHeader(QtRestClient::RequestSigner::ContentHashHeader), QByteArray("037c9214eef74cc3887f3a4f085b4e17d76280dafd273b0ee160c09c4ba1cfd4"));
+	QCOMPARE(request.rawHeader("Authorization"),
+			 QByteArray("AWS4-HMAC-SHA256 Credential=AKIDEXAMPLE/20150830/us-east-1/service/aws4_request, "
+						"SignedHeaders=content-type;host;x-amz-content-sha256;x-amz-date, "
+						"Signature=c4f19ee4e5fad22279822d5802688956993649c01773d39f731b3dbf69a66064"));
+
+	//seekable devices are hashed in place, and rewound
+	QBuffer buffer;
+	buffer.setData("{\"id\":1}");
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	auto deviceBuilder = builder;
+	deviceBuilder.setBody(&buffer, "application/json");
+	signer.sign(deviceBuilder, timestamp);
+	QCOMPARE(deviceBuilder.build().rawHeader("Authorization"), request.rawHeader("Authorization"));
+	QCOMPARE(buffer.pos(), 0ll);
+
+	//multipart bodies are not signed
+	auto multiPartBuilder = builder;
+	multiPartBuilder.addPart("id", "1");
+	signer.sign(multiPartBuilder, timestamp);
+	QCOMPARE(multiPartBuilder.build().rawHeader(QtRestClient::RequestSigner::ContentHashHeader), QtRestClient::RequestSigner::UnsignedPayload);
+}
+
+void RequestBuilderTest::testBodyDevice()
+{
+	QJsonObject object;
+	object["userId"] = 1;
+	object["id"] = 2;
+	object["title"] = "device";
+	object["body"] = "streamed";
+
+	auto buffer = new QBuffer(this);
+	buffer->setData(QJsonDocument(object).toJson(QJsonDocument::Compact));
+	QVERIFY(buffer->open(QIODevice::ReadOnly));
+
+	auto builder = QtRestClient::RequestBuilder(server->url("posts/2"), nam);
+	builder.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
+	builder.setVerb("PUT");
+	builder.setBody(buffer, "application/json");
+	QCOMPARE(builder.bodyDevice(), buffer);
+	QCOMPARE(builder.headers().value("Content-Type"), QByteArray("application/json"));
+
+	auto reply = builder.send();
+	QSignalSpy replySpy(reply, &QNetworkReply::finished);
+	QVERIFY(replySpy.wait());
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(QJsonDocument::fromJson(reply->readAll()).object(), object);
+
+	//the device stays with the caller
+	QCOMPARE(buffer->parent(), this);
+	delete reply;
+	QCOMPARE(buffer->parent(), this);
+	delete buffer;
+
+	//sequential devices cannot be sent again
+	SequentialBuffer sequential;
+	sequential.setData(QJsonDocument(object).toJson(QJsonDocument::Compact));
+	QVERIFY(sequential.open(QIODevice::ReadOnly));
+	builder.setBody(&sequential, "application/json");
+	qRegisterMetaType<QtRestClient::RestReply::ErrorType>();
+	auto restReply = new QtRestClient::RestReply(builder.send(), this);
+	restReply->onSucceeded([&](int, QJsonObject){
+		restReply->retry();
+	});
+	QSignalSpy errorSpy(restReply, &QtRestClient::RestReply::error);
+	QVERIFY(errorSpy.wait());
+	QCOMPARE(errorSpy.first()[1].toInt(), static_cast<int>(QNetworkReply::ContentReSendError));
+}
+
+void RequestBuilderTest::testMultiPart()
+{
+	QBuffer file;
+	file.setData("file-content");
+	QVERIFY(file.open(QIODevice::ReadOnly));
+
+	auto builder = QtRestClient::RequestBuilder(server->url("posts/1"), nam);
+	builder.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
+	builder.setVerb("POST");
+	builder.setBody(QByteArray("replaced"), "text/plain");
+	builder.addPart("id", "1", "text/plain")
+			.addPart("file", &file, "application/octet-stream", QStringLiteral("file.txt"))
+			.setMultiPartType(QHttpMultiPart::RelatedType);
+	QVERIFY(builder.hasMultiPartBody());
+	QVERIFY(builder.body().isEmpty());
+	QVERIFY(!builder.headers().contains("Content-Type"));
+
+	auto reply = builder.send();
+	QVERIFY(reply->request().header(QNetworkRequest::ContentTypeHeader).toByteArray().startsWith("multipart/related"));
+	QSignalSpy replySpy(reply, &QNetworkReply::finished);
+	QVERIFY(replySpy.wait());
+	delete reply;
+
+	//part devices are not taken over
+	QVERIFY(!file.parent());
+	QVERIFY(file.isOpen());
+}
+
+void RequestBuilderTest::testParallelDownload_data()
+{
+	QTest::addColumn<bool>("rangesEnabled");
+	QTest::addColumn<bool>("headEnabled");
+	QTest::addColumn<bool>("ranged");
+
+	QTest::newRow("single") << false << true << false;
+	QTest::newRow("ranged") << true << true << true;
+	QTest::newRow("headFallback") << true << false << false;
+}
+
+void RequestBuilderTest::testParallelDownload()
+{
+	QFETCH(bool, rangesEnabled);
+	QFETCH(bool, headEnabled);
+	QFETCH(bool, ranged);
+
+	server->setRangesEnabled(rangesEnabled);
+	server->setHeadEnabled(headEnabled);
+	auto expected = QJsonDocument(server->obtainData({"posts"}).toArray()).toJson(QJsonDocument::Compact);
+
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	auto builder = QtRestClient::RequestBuilder(server->url("posts"), nam);
+	builder.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
+	QtRestClient::ParallelDownload download(builder, dir.filePath(QStringLiteral("posts.json")));
+	download.setMinimumRangeSize(expected.size() / 8);
+
+	QSignalSpy finishedSpy(&download, &QtRestClient::ParallelDownload::finished);
+	QSignalSpy errorSpy(&download, &QtRestClient::ParallelDownload::error);
+	download.start();
+	QVERIFY(finishedSpy.wait());
+	QVERIFY(errorSpy.isEmpty());
+	QCOMPARE(download.isRanged(), ranged);
+	QCOMPARE(download.bytesReceived(), static_cast<qint64>(expected.size()));
+
+	QFile file(download.filePath());
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QCOMPARE(file.readAll(), expected);
+	file.close();
+
+	//file errors are reported as such
+	qRegisterMetaType<QtRestClient::ParallelDownload::ErrorType>();
+	QtRestClient::ParallelDownload failing(builder, dir.filePath(QStringLiteral("missing/posts.json")));
+	QSignalSpy failingSpy(&failing, &QtRestClient::ParallelDownload::error);
+	failing.start();
+	QVERIFY(failingSpy.wait());
+	QCOMPARE(failingSpy.first()[2].value<QtRestClient::ParallelDownload::ErrorType>(), QtRestClient::ParallelDownload::FileError);
+
+	//full responses to range requests are rejected instead of being buffered
+	if(ranged) {
+		server->setRangesIgnored(true);
+		QtRestClient::ParallelDownload ignored(builder, dir.filePath(QStringLiteral("ignored.json")));
+		ignored.setMinimumRangeSize(expected.size() / 8);
+		QSignalSpy ignoredSpy(&ignored, &QtRestClient::ParallelDownload::error);
+		ignored.start();
+		QVERIFY(ignoredSpy.wait());
+		QCOMPARE(ignoredSpy.first()[1].toInt(), static_cast<int>(QNetworkReply::ProtocolFailure));
+		QVERIFY(!QFile::exists(ignored.filePath()));
+		server->setRangesIgnored(false);
+	}
+
+	server->setRangesEnabled(false);
+	server->setHeadEnabled(true);
+}
+
 QTEST_MAIN(RequestBuilderTest)
 
 #include "tst_requestbuilder.moc"
@@ -15,6 +15,7 @@ private Q_SLOTS:
 	void testCustomCompiledGadget();
 	void testCustomCompiledApi();
 	void testCustomCompiledApiPosts();
+	void testCustomCompiledWarmUp();
 
 private:
 	HttpServer *server;
@@ -165,6 +166,19 @@ void RestBuilderTest::testCustomCompiledApiPosts()
 	QVERIFY(called);
 }
 
+void RestBuilderTest::testCustomCompiledWarmUp()
+{
+	//drop the client created on startup, to see the generated one connect
+	QtRestClient::removeGlobalApi(QStringLiteral("localhost"), true);
+	QCoreApplication::processEvents();
+
+	QSignalSpy connectionSpy(server, &QTcpServer::newConnection);
+	QVERIFY(!QtRestClient::apiClient(QStringLiteral("localhost")));
+	TestApi::factory();
+	QVERIFY(QtRestClient::apiClient(QStringLiteral("localhost")));
+	QVERIFY(connectionSpy.wait());
+}
+
 QTEST_MAIN(RestBuilderTest)
 
 #include "tst_restbuilder.moc"
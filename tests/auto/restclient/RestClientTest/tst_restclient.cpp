@@ -9,6 +9,10 @@ private Q_SLOTS:
 
 	void testBaseUrl_data();
 	void testBaseUrl();
+
+	void testTlsSessionCache();
+	void testTransportProfile();
+	void testWarmUp();
 };
 
 void RestClientTest::initTestCase()
@@ -74,6 +78,97 @@ void RestClientTest::testBaseUrl()
 	QCOMPARE(request.sslConfiguration(), sslConfig);
 }
 
+void RestClientTest::testTlsSessionCache()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	auto path = dir.filePath(QStringLiteral("sessions"));
+	QByteArray ticket("ticket-data");
+
+	{
+		QtRestClient::TlsSessionCache cache(path);
+		cache.storeSessionTicket(QStringLiteral("api.example.com"), 443, ticket, 3600);
+		QCOMPARE(cache.sessionTicket(QStringLiteral("API.example.com"), 443), ticket);
+		QVERIFY(cache.sessionTicket(QStringLiteral("api.example.com"), 8443).isEmpty());
+		QVERIFY(cache.save());
+	}
+
+	QtRestClient::TlsSessionCache cache(path);
+	QCOMPARE(cache.sessionTicket(QStringLiteral("api.example.com"), 443), ticket);
+
+	QtRestClient::RestClient client;
+	client.setBaseUrl(QUrl(QStringLiteral("https://api.example.com/basic")));
+	auto request = client.builder().build();
+	QVERIFY(request.sslConfiguration().sessionTicket().isEmpty());
+
+	client.setTlsSessionCache(&cache);
+	request = client.builder().build();
+	QCOMPARE(request.sslConfiguration().sessionTicket(), ticket);
+	QVERIFY(!request.sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence));
+}
+
+void RestClientTest::testTransportProfile()
+{
+	QtRestClient::RestClient client;
+	client.setBaseUrl(QUrl(QStringLiteral("http://internal.example.com")));
+
+	//without a profile, the defaults of Qt are kept
+	auto request = client.builder().build();
+	QVERIFY(!request.attribute(QNetworkRequest::HTTP2AllowedAttribute).isValid());
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	QCOMPARE(request.http2Configuration(), QNetworkRequest().http2Configuration());
+#endif
+
+	client.setTransportProfile(QtRestClient::TransportProfile());
+	request = client.builder().build();
+	QCOMPARE(request.attribute(QNetworkRequest::HTTP2AllowedAttribute).toBool(), false);
+
+	client.setTransportProfile(QtRestClient::TransportProfile(QtRestClient::TransportProfile::Http2PriorKnowledge)
+							   .setStreamReceiveWindowSize(1024 * 1024));
+	request = client.builder().build();
+	QCOMPARE(request.attribute(QNetworkRequest::HTTP2AllowedAttribute).toBool(), true);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+	QCOMPARE(request.attribute(QNetworkRequest::Http2DirectAttribute).toBool(), true);
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	QCOMPARE(request.http2Configuration().streamReceiveWindowSize(), 1024u * 1024u);
+	//unset values keep the tuned defaults of Qt
+	QCOMPARE(request.http2Configuration().sessionReceiveWindowSize(),
+			 QNetworkRequest().http2Configuration().sessionReceiveWindowSize());
+#endif
+
+	//explicit attributes override the profile
+	client.addRequestAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
+	request = client.builder().build();
+	QCOMPARE(request.attribute(QNetworkRequest::HTTP2AllowedAttribute).toBool(), false);
+}
+
+void RestClientTest::testWarmUp()
+{
+	HttpServer server;
+	server.verifyRunning();
+	QtRestClient::RestClient client;
+
+	//no base url, nothing to connect to
+	QSignalSpy connectionSpy(&server, &QTcpServer::newConnection);
+	client.warmUp();
+	QVERIFY(!connectionSpy.wait(500));
+
+	client.setBaseUrl(server.url(QString()));
+	QVERIFY(!connectionSpy.wait(500));
+	client.warmUp();
+	QVERIFY(connectionSpy.wait());
+
+	//automatic warm up whenever the url changes
+	HttpServer autoServer;
+	autoServer.verifyRunning();
+	QSignalSpy autoSpy(&autoServer, &QTcpServer::newConnection);
+	client.setAutoWarmUp(true);
+	QVERIFY(client.autoWarmUp());
+	client.setBaseUrl(autoServer.url(QString()));
+	QVERIFY(autoSpy.wait());
+}
+
 QTEST_MAIN(RestClientTest)
 
 #include "tst_restclient.moc"
@@ -3,6 +3,135 @@
 
 #include <jphpost.h>
 
+#include <algorithm>
+
+class TestInterceptor : public QtRestClient::RequestInterceptor
+{
+public:
+	QByteArray name;
+	QByteArrayList *replyOrder = nullptr;
+
+	QNetworkReply *interceptRequest(QtRestClient::RequestBuilder &builder) override {
+		builder.addHeader("X-Interceptor", name);
+		if(builder.buildUrl().path().endsWith(QStringLiteral("/cached"))) {
+			auto reply = new QtRestClient::StaticReply(builder.build(), 200, "{\"id\":42}");
+			reply->setAttribute(QNetworkRequest::SourceIsFromCacheAttribute, true);
+			return reply;
+		}
+		return nullptr;
+	}
+
+	void interceptReply(QNetworkReply *, int &status, QByteArray &data) override {
+		replyOrder->append(name);
+		if(status == 404) {
+			status = 410;
+			data = "{\"id\":0}";
+		}
+	}
+};
+
+class RecordingInterceptor : public QtRestClient::RequestInterceptor
+{
+public:
+	QList<QUrl> urls;
+
+	QNetworkReply *interceptRequest(QtRestClient::RequestBuilder &builder) override {
+		urls.append(builder.buildUrl());
+		return nullptr;
+	}
+};
+
+class BulkInterceptor : public QtRestClient::RequestInterceptor
+{
+public:
+	QStringList requestedIds;
+	QStringList extraIds;
+	int running = 0;
+	int maxRunning = 0;
+
+	QNetworkReply *interceptRequest(QtRestClient::RequestBuilder &builder) override {
+		auto url = builder.buildUrl();
+		if(!url.path().endsWith(QStringLiteral("/bulk")))
+			return nullptr;
+
+		QJsonArray posts;
+		auto ids = QUrlQuery(url).queryItemValue(QStringLiteral("ids"), QUrl::FullyDecoded);
+		requestedIds.append(ids);
+		for(const auto &id : ids.split(QLatin1Char(',')) + extraIds) {
+			posts.append(QJsonObject {
+				{QStringLiteral("id"), id.toInt()},
+				{QStringLiteral("userId"), 1},
+				{QStringLiteral("title"), QStringLiteral("Title") + id},
+				{QStringLiteral("body"), QStringLiteral("Body") + id}
+			});
+		}
+		auto reply = new QtRestClient::StaticReply(builder.build(), 200, QJsonDocument(posts).toJson(QJsonDocument::Compact));
+		maxRunning = qMax(maxRunning, ++running);
+		QObject::connect(reply, &QNetworkReply::finished, [this](){
+			running--;
+		});
+		return reply;
+	}
+};
+
+class TestAuthenticator : public QtRestClient::Authenticator
+{
+public:
+	int refreshCount = 0;
+	bool completes = true;
+
+	TestAuthenticator(QtRestClient::RestClient *client) :
+		Authenticator(client)
+	{}
+
+protected:
+	void startRefresh() override {
+		refreshCount++;
+		if(!completes)
+			return;
+		QTimer::singleShot(10, this, [this](){
+			completeRefresh(QStringLiteral("fresh"), 3600);
+		});
+	}
+};
+
+class FailingAuthenticator : public QtRestClient::Authenticator
+{
+public:
+	int refreshCount = 0;
+
+	FailingAuthenticator(QtRestClient::RestClient *client) :
+		Authenticator(client)
+	{}
+
+protected:
+	void startRefresh() override {
+		refreshCount++;
+		failRefresh(QStringLiteral("invalid_grant"));
+	}
+};
+
+class FailingInterceptor : public QtRestClient::RequestInterceptor
+{
+public:
+	int requestCount = 0;
+
+	QNetworkReply *interceptRequest(QtRestClient::RequestBuilder &builder) override {
+		requestCount++;
+		return new QtRestClient::StaticReply(builder.build(), 503, "{}");
+	}
+};
+
+class UnauthorizedInterceptor : public QtRestClient::RequestInterceptor
+{
+public:
+	QNetworkReply *interceptRequest(QtRestClient::RequestBuilder &builder) override {
+		if(builder.build().rawHeader("Authorization") != "Bearer fresh")
+			return new QtRestClient::StaticReply(builder.build(), 401, "{}");
+		return nullptr;
+	}
+};
+
 class RestReplyTest : public QObject
 {
 	Q_OBJECT
@@ -17,6 +146,13 @@ private Q_SLOTS:
 	void testReplyWrapping();
 	void testReplyError();
 	void testReplyRetry();
+	void testReplyMetrics();
+	void testReplyTracing();
+	void testInterceptors();
+	void testAuthenticator();
+	void testOfflineQueue();
+	void testFutures();
+	void testSyncCalls();
 
 	void testGenericReplyWrapping_data();
 	void testGenericReplyWrapping();
@@ -31,9 +167,20 @@ private Q_SLOTS:
 	void testGenericPagingReplyWrapping();
 	void testPagingNext();
 	void testPagingPrevious();
+	void testPagingIterate_data();
 	void testPagingIterate();
+	void testPagingIterateParallel_data();
+	void testPagingIterateParallel();
+	void testPagingStream();
+	void testPageCache();
+	void testPagingFactories();
+	void testPagingModel_data();
+	void testPagingModel();
+	void testPagingOwnsItems();
+	void testPagingCollect();
 
 	void testSimpleExtension();
+	void testSimpleExtendAll();
 	void testSimplePagingIterate();
 
 private:
@@ -162,6 +309,402 @@ void RestReplyTest::testReplyRetry()
 	QVERIFY(deleteSpy.wait(14000));
 	QVERIFY(retryCount);
 	QCOMPARE(retryCount, 3);
+
+	//replies without a manager or client fail their retry instead
+	auto orphanError = 0;
+	auto orphan = new QtRestClient::RestReply(new QtRestClient::StaticReply(QNetworkRequest(server->url("posts/1")), 503, "{}"));
+	orphan->onFailed([&](int, QJsonObject){
+		orphan->retry();
+	});
+	orphan->onError([&](QString, int code, QtRestClient::RestReply::ErrorType type){
+		QCOMPARE(type, QtRestClient::RestReply::NetworkError);
+		orphanError = code;
+	});
+	QSignalSpy orphanSpy(orphan, &QtRestClient::RestReply::destroyed);
+	QVERIFY(orphanSpy.wait());
+	QCOMPARE(orphanError, (int)QNetworkReply::ProtocolUnknownError);
+}
+
+void RestReplyTest::testReplyMetrics()
+{
+	QSignalSpy completedSpy(client, &QtRestClient::RestClient::requestCompleted);
+	QtRestClient::RequestMetrics replyMetrics;
+	auto before = client->metricsSnapshot();
+
+	auto postClass = client->createClass(QStringLiteral("posts"), this);
+	auto reply = postClass->get<JphPost*>(QStringLiteral("1"));
+	QCOMPARE(client->metricsSnapshot().inFlight(), before.inFlight() + 1);
+	reply->onSucceeded([&](int, JphPost *post){
+		replyMetrics = reply->metrics();
+		post->deleteLater();
+	});
+
+	QVERIFY(completedSpy.wait());
+	QCOMPARE(completedSpy.size(), 1);
+	auto metrics = completedSpy.takeFirst()[0].value<QtRestClient::RequestMetrics>();
+	QCOMPARE(metrics.url(), server->url("posts/1"));
+	QCOMPARE(metrics.verb(), QByteArray("GET"));
+	QCOMPARE(metrics.route(), QStringLiteral("posts"));
+	QCOMPARE(metrics.status(), 200);
+	QVERIFY(metrics.bytesReceived() > 0);
+	QCOMPARE(metrics.timestamp(QtRestClient::RequestMetrics::Created), 0ll);
+	QVERIFY(metrics.hasPhase(QtRestClient::RequestMetrics::FirstByte));
+	QVERIFY(metrics.duration(QtRestClient::RequestMetrics::Finished, QtRestClient::RequestMetrics::Parsed) >= 0);
+	QVERIFY(metrics.duration(QtRestClient::RequestMetrics::Parsed, QtRestClient::RequestMetrics::Deserialized) >= 0);
+	QVERIFY(metrics.duration(QtRestClient::RequestMetrics::Deserialized, QtRestClient::RequestMetrics::HandlerDone) >= 0);
+	QVERIFY(!metrics.hasPhase(QtRestClient::RequestMetrics::Encrypted));
+	//the handler sees the record before all handlers are done
+	QVERIFY(replyMetrics.hasPhase(QtRestClient::RequestMetrics::Deserialized));
+	QVERIFY(!replyMetrics.hasPhase(QtRestClient::RequestMetrics::HandlerDone));
+
+	auto snapshot = client->metricsSnapshot();
+	QCOMPARE(snapshot.inFlight(), before.inFlight());
+	QCOMPARE(snapshot.requestCount(), before.requestCount() + 1);
+	QCOMPARE(snapshot.bytesReceived(), before.bytesReceived() + metrics.bytesReceived());
+	QCOMPARE(snapshot.deserializeDuration().count, before.deserializeDuration().count + 1);
+	auto text = snapshot.toPrometheus();
+	QVERIFY(text.contains("qtrestclient_requests_total{verb=\"GET\",status_class=\"2xx\",route=\"posts\"} 1\n"));
+	QVERIFY(text.contains("# TYPE qtrestclient_request_duration_seconds histogram\n"));
+	QVERIFY(text.contains("qtrestclient_request_duration_seconds_bucket{le=\"+Inf\"} " + QByteArray::number(snapshot.requestCount()) + "\n"));
+	postClass->deleteLater();
+}
+
+void RestReplyTest::testReplyTracing()
+{
+	QtRestClient::Tracer tracer;
+	QSignalSpy spanSpy(&tracer, &QtRestClient::Tracer::spanFinished);
+	auto parent = QByteArrayLiteral("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01");
+	tracer.setParentContext(parent, "vendor=value");
+	client->setTracer(&tracer);
+
+	auto reply = client->createClass(QStringLiteral("posts"), this)->get(QStringLiteral("1"));
+	auto traceParent = reply->networkReply()->request().rawHeader(QtRestClient::Tracer::TraceParentHeader);
+	QVERIFY(QtRestClient::Tracer::isValidTraceParent(traceParent));
+	QVERIFY(traceParent.startsWith("00-0af7651916cd43dd8448eb211c80319c-"));
+	QVERIFY(traceParent != parent);
+	QCOMPARE(reply->networkReply()->request().rawHeader(QtRestClient::Tracer::TraceStateHeader), QByteArray("vendor=value"));
+
+	QVERIFY(spanSpy.wait());
+	auto span = spanSpy.takeFirst()[0].toJsonObject();
+	QCOMPARE(span[QStringLiteral("traceId")].toString(), QStringLiteral("0af7651916cd43dd8448eb211c80319c"));
+	QCOMPARE(span[QStringLiteral("spanId")].toString(), QString::fromLatin1(traceParent.split('-')[2]));
+	QCOMPARE(span[QStringLiteral("parentSpanId")].toString(), QStringLiteral("b7ad6b7169203331"));
+	QCOMPARE(span[QStringLiteral("name")].toString(), QStringLiteral("GET posts"));
+
+	client->setTracer(nullptr);
+	QVERIFY(!QtRestClient::Tracer::isValidTraceParent("00-00000000000000000000000000000000-b7ad6b7169203331-01"));
+}
+
+void RestReplyTest::testInterceptors()
+{
+	QByteArrayList replyOrder;
+	auto first = new TestInterceptor();
+	first->name = "first";
+	first->replyOrder = &replyOrder;
+	auto second = new TestInterceptor();
+	second->name = "second";
+	second->replyOrder = &replyOrder;
+	client->addInterceptor(second);
+	client->insertInterceptor(0, first);
+	QCOMPARE(client->interceptors(), QList<QtRestClient::RequestInterceptor*>({first, second}));
+
+	//passed through: both see the request in order and the reply in reverse order
+	auto reply = client->rootClass()->get(QStringLiteral("posts/1"));
+	QCOMPARE(reply->networkReply()->request().rawHeader("X-Interceptor"), QByteArray("second"));
+	QSignalSpy completedSpy(reply, &QtRestClient::RestReply::completed);
+	QVERIFY(completedSpy.wait());
+	QCOMPARE(completedSpy.takeFirst()[0].toInt(), 200);
+	QCOMPARE(replyOrder, QByteArrayList({"second", "first"}));
+
+	//rewritten by the reply interceptors
+	replyOrder.clear();
+	reply = client->rootClass()->get(QStringLiteral("posts/baum"));
+	QSignalSpy rewrittenSpy(reply, &QtRestClient::RestReply::failed);
+	QVERIFY(rewrittenSpy.wait());
+	auto rewritten = rewrittenSpy.takeFirst();
+	QCOMPARE(rewritten[0].toInt(), 410);
+	QCOMPARE(rewritten[1].toJsonValue().toObject()[QStringLiteral("id")].toInt(), 0);
+
+	//short-circuited by the first interceptor
+	replyOrder.clear();
+	QSignalSpy metricsSpy(client, &QtRestClient::RestClient::requestCompleted);
+	reply = client->rootClass()->get(QStringLiteral("posts/cached"));
+	QSignalSpy cachedSpy(reply, &QtRestClient::RestReply::succeeded);
+	QVERIFY(cachedSpy.wait());
+	QCOMPARE(cachedSpy.takeFirst()[1].toJsonValue().toObject()[QStringLiteral("id")].toInt(), 42);
+	QCOMPARE(replyOrder, QByteArrayList({"first"}));
+	QCOMPARE(metricsSpy.size(), 1);
+	QVERIFY(metricsSpy.takeFirst()[0].value<QtRestClient::RequestMetrics>().fromCache());
+
+	//only the interceptors that saw the request see the reply, even if the chain changed since
+	replyOrder.clear();
+	reply = client->rootClass()->get(QStringLiteral("posts/1"));
+	auto third = new TestInterceptor();
+	third->name = "third";
+	third->replyOrder = &replyOrder;
+	client->insertInterceptor(0, third);
+	client->insertInterceptor(0, nullptr);
+	client->removeInterceptor(second);
+	delete first;
+	QCOMPARE(client->interceptors(), QList<QtRestClient::RequestInterceptor*>({third}));
+	QSignalSpy changedSpy(reply, &QtRestClient::RestReply::completed);
+	QVERIFY(changedSpy.wait());
+	QCOMPARE(replyOrder, QByteArrayList({"second"}));
+
+	client->removeInterceptor(third);
+	client->removeInterceptor(nullptr);
+	QVERIFY(client->interceptors().isEmpty());
+	delete second;
+	delete third;
+}
+
+void RestReplyTest::testAuthenticator()
+{
+	auto authenticator = new TestAuthenticator(client);
+	auto unauthorized = new UnauthorizedInterceptor();
+	client->addInterceptor(unauthorized);
+	authenticator->setAccessToken(QStringLiteral("stale"));
+	QCOMPARE(client->globalHeaders().value("Authorization"), QByteArray("Bearer stale"));
+
+	//all concurrent 401s share a single refresh, and are replayed transparently
+	auto succeeded = 0;
+	auto completed = 0;
+	for(auto i = 0; i < 5; i++) {
+		auto reply = client->rootClass()->get(QStringLiteral("posts/1"));
+		reply->onSucceeded([&](int status, QJsonObject){
+			QCOMPARE(status, 200);
+			succeeded++;
+		});
+		reply->onFailed([](int status, QJsonObject){
+			QFAIL(qUtf8Printable(QStringLiteral("Unexpected failure with status %1").arg(status)));
+		});
+		reply->onCompleted([&](int){
+			completed++;
+		});
+	}
+	QTRY_COMPARE_WITH_TIMEOUT(succeeded, 5, 5000);
+	QTest::qWait(100);
+	QCOMPARE(completed, 5);
+	QCOMPARE(authenticator->refreshCount, 1);
+	QCOMPARE(authenticator->accessToken(), QStringLiteral("fresh"));
+	QVERIFY(authenticator->expiresAt().isValid());
+	QCOMPARE(client->globalHeaders().value("Authorization"), QByteArray("Bearer fresh"));
+
+	//deleting the authenticator passes on the 401 of the parked replies
+	authenticator->completes = false;
+	authenticator->setAccessToken(QStringLiteral("stale"));
+	auto parkedStatus = 0;
+	auto parkedReply = client->rootClass()->get(QStringLiteral("posts/1"));
+	parkedReply->onFailed([&](int status, QJsonObject){
+		parkedStatus = status;
+	});
+	QTRY_COMPARE_WITH_TIMEOUT(authenticator->refreshCount, 2, 5000);
+	QVERIFY(authenticator->isRefreshing());
+	QCOMPARE(parkedStatus, 0);
+	client->removeInterceptor(authenticator);
+	delete authenticator;
+	QCOMPARE(parkedStatus, 401);
+
+	client->removeInterceptor(unauthorized);
+	client->removeGlobalHeader("Authorization");
+	delete unauthorized;
+
+	//a failed refresh is not repeated for every following request
+	auto failing = new FailingAuthenticator(client);
+	QSignalSpy failedSpy(failing, &QtRestClient::Authenticator::refreshFailed);
+	failing->setAccessToken(QStringLiteral("expired"), 0);
+	for(auto i = 0; i < 3; i++) {
+		auto reply = client->rootClass()->get(QStringLiteral("posts/1"));
+		QSignalSpy completedSpy(reply, &QtRestClient::RestReply::completed);
+		QVERIFY(completedSpy.wait());
+	}
+	QCOMPARE(failing->refreshCount, 1);
+	QCOMPARE(failedSpy.size(), 1);
+	QCOMPARE(failedSpy.first()[0].toString(), QStringLiteral("invalid_grant"));
+	QVERIFY(!failing->isRefreshing());
+
+	//explicit refreshes are still possible
+	failing->refresh();
+	QCOMPARE(failing->refreshCount, 2);
+
+	client->removeInterceptor(failing);
+	client->removeGlobalHeader("Authorization");
+	delete failing;
+}
+
+void RestReplyTest::testOfflineQueue()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	auto path = dir.filePath(QStringLiteral("queue"));
+
+	auto queue = new QtRestClient::OfflineQueue(client, path);
+	queue->setOnline(false);
+	QList<QUuid> ids;
+	for(auto i = 1; i <= 3; i++) {
+		ids.append(queue->enqueue(client->rootClass()->builder()
+								  .addPath({QStringLiteral("posts"), QString::number(i)})
+								  .addHeader("Authorization", "Bearer secret")));
+	}
+	QCOMPARE(queue->pendingRequests(), ids);
+
+	//the journal survives the queue, without credentials
+	QFile file(path);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QVERIFY(!file.readAll().contains("secret"));
+	file.close();
+	auto restored = new QtRestClient::OfflineQueue(client, path);
+	QCOMPARE(restored->pendingRequests(), ids);
+	delete restored;
+
+	QList<QUuid> completed;
+	QSignalSpy completedSpy(queue, &QtRestClient::OfflineQueue::requestCompleted);
+	auto handled = false;
+	queue->onCompleted(ids[1], [&](int status, QJsonValue reply){
+		QCOMPARE(status, 200);
+		QCOMPARE(reply.toObject()[QStringLiteral("id")].toInt(), 2);
+		handled = true;
+	});
+	queue->setOnline(true);
+	QTRY_COMPARE_WITH_TIMEOUT(completedSpy.size(), 3, 5000);
+	for(auto signal : completedSpy)
+		completed.append(signal[0].toUuid());
+	std::sort(completed.begin(), completed.end());
+	std::sort(ids.begin(), ids.end());
+	QCOMPARE(completed, ids);
+	QVERIFY(handled);
+	QCOMPARE(queue->pendingCount(), 0);
+	delete queue;
+
+	QtRestClient::OfflineQueue emptyQueue(client, path);
+	QVERIFY(emptyQueue.pendingRequests().isEmpty());
+}
+
+void RestReplyTest::testFutures()
+{
+	auto postClass = client->createClass(QStringLiteral("posts"), this);
+
+	QList<QFuture<QJsonValue>> futures;
+	for(auto i = 1; i <= 3; i++)
+		futures.append(postClass->callJson(QtRestClient::RestClass::GetVerb, QString::number(i))->toFuture());
+	auto all = QtRestClient::whenAll(futures);
+	QFutureWatcher<QList<QJsonValue>> allWatcher;
+	QSignalSpy allSpy(&allWatcher, &QFutureWatcherBase::finished);
+	allWatcher.setFuture(all);
+	QVERIFY(allSpy.wait());
+	auto values = all.result();
+	QCOMPARE(values.size(), 3);
+	for(auto i = 0; i < values.size(); i++)
+		QCOMPARE(values[i].toObject()[QStringLiteral("id")].toInt(), i + 1);
+
+	//the first failure fails the whole future
+	auto failed = QtRestClient::whenAll(QList<QFuture<QJsonValue>> {
+		postClass->callJson(QtRestClient::RestClass::GetVerb, QStringLiteral("1"))->toFuture(),
+		postClass->callJson(QtRestClient::RestClass::GetVerb, QStringLiteral("baum"))->toFuture()
+	});
+	QFutureWatcher<QList<QJsonValue>> failedWatcher;
+	QSignalSpy failedSpy(&failedWatcher, &QFutureWatcherBase::finished);
+	failedWatcher.setFuture(failed);
+	QVERIFY(failedSpy.wait());
+	try {
+		failed.waitForFinished();
+		QFAIL("Expected a RestReplyException");
+	} catch(QtRestClient::RestReplyException &e) {
+		QCOMPARE(e.errorType(), QtRestClient::RestReply::FailureError);
+		QCOMPARE(e.error(), 404);
+	}
+
+	//handlers added later don't keep the future from finishing
+	auto badReply = client->rootClass()->get<JphPost*>(QStringLiteral("posts"));
+	auto badFuture = badReply->toFuture();
+	auto badHandled = false;
+	badReply->onAllErrors([&](QString, int, QtRestClient::RestReply::ErrorType type){
+		QCOMPARE(type, QtRestClient::RestReply::DeserializationError);
+		badHandled = true;
+	});
+	QFutureWatcher<JphPost*> badWatcher;
+	QSignalSpy badSpy(&badWatcher, &QFutureWatcherBase::finished);
+	badWatcher.setFuture(badFuture);
+	QVERIFY(badSpy.wait());
+	QVERIFY(badHandled);
+	try {
+		badFuture.result();
+		QFAIL("Expected a RestReplyException");
+	} catch(QtRestClient::RestReplyException &e) {
+		QCOMPARE(e.errorType(), QtRestClient::RestReply::DeserializationError);
+	}
+
+	//results keep the order of the inputs
+	auto maxRunning = 0;
+	auto running = 0;
+	auto mapped = QtRestClient::mapConcurrent(QList<int> {3, 1, 4, 2}, 2, [&](int id){
+		maxRunning = qMax(maxRunning, ++running);
+		auto reply = postClass->get<JphPost*>(QString::number(id));
+		reply->onCompleted([&](int){
+			running--;
+		});
+		return reply->toFuture();
+	});
+	QFutureWatcher<JphPost*> mappedWatcher;
+	QSignalSpy mappedSpy(&mappedWatcher, &QFutureWatcherBase::finished);
+	mappedWatcher.setFuture(mapped);
+	QVERIFY(mappedSpy.wait());
+	QCOMPARE(maxRunning, 2);
+	auto posts = mapped.results();
+	QCOMPARE(posts.size(), 4);
+	QCOMPARE(posts[0]->id, 3);
+	QCOMPARE(posts[1]->id, 1);
+	QCOMPARE(posts[2]->id, 4);
+	QCOMPARE(posts[3]->id, 2);
+	qDeleteAll(posts);
+
+	postClass->deleteLater();
+}
+
+void RestReplyTest::testSyncCalls()
+{
+	auto postClass = client->createClass(QStringLiteral("posts"), this);
+
+	//blocking the thread of the class is refused instead of deadlocking
+	auto local = postClass->callJsonSync(QtRestClient::RestClass::GetVerb, QStringLiteral("1"));
+	QVERIFY(!local);
+	QCOMPARE(local.error().error(), static_cast<int>(QNetworkReply::OperationNotImplementedError));
+
+	auto id = 0;
+	auto status = 0;
+	QScopedPointer<QThread> thread(QThread::create([&](){
+		auto post = postClass->getSync<JphPost*>(QStringLiteral("1"));
+		if(post) {
+			id = post.value()->id;
+			post.value()->deleteLater();
+		}
+		auto failed = postClass->callJsonSync(QtRestClient::RestClass::GetVerb, QStringLiteral("baum"));
+		if(!failed)
+			status = failed.error().error();
+	}));
+	QSignalSpy finishedSpy(thread.data(), &QThread::finished);
+	thread->start();
+	QVERIFY(finishedSpy.wait());
+	QCOMPARE(id, 1);
+	QCOMPARE(status, 404);
+
+	//a blocked class thread makes the call time out instead of waiting forever
+	client->setSyncTimeout(200);
+	auto timeoutError = 0;
+	QScopedPointer<QThread> blocked(QThread::create([&](){
+		auto result = postClass->callJsonSync(QtRestClient::RestClass::GetVerb, QStringLiteral("1"));
+		if(!result)
+			timeoutError = result.error().error();
+	}));
+	blocked->start();
+	QVERIFY(blocked->wait(5000));
+	QCOMPARE(timeoutError, static_cast<int>(QNetworkReply::TimeoutError));
+	client->setSyncTimeout(0);
+	//the abandoned call is not started anymore
+	QSignalSpy requestSpy(client, &QtRestClient::RestClient::requestCompleted);
+	QVERIFY(!requestSpy.wait(500));
+
+	postClass->deleteLater();
 }
 
 void RestReplyTest::testGenericReplyWrapping_data()
@@ -550,8 +1093,21 @@ void RestReplyTest::testPagingPrevious()
 	QVERIFY(called);
 }
 
+void RestReplyTest::testPagingIterate_data()
+{
+	QTest::addColumn<bool>("prefetch");
+
+	QTest::newRow("sequential") << false;
+	QTest::newRow("prefetch") << true;
+}
+
 void RestReplyTest::testPagingIterate()
 {
+	QFETCH(bool, prefetch);
+	client->setPagingPrefetch(prefetch);
+	auto recorder = new RecordingInterceptor();
+	client->addInterceptor(recorder);
+
 	QNetworkRequest request(server->url("pages/0"));
 	request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
 
@@ -562,6 +1118,9 @@ void RestReplyTest::testPagingIterate()
 		[&](){
 			QCOMPARE(index, count);
 			QCOMPARE(data->id, count);//validating the id is enough
+			//with prefetching, the next page is already requested while the first item is handled
+			if(index % 10 == 0)
+				QCOMPARE(recorder->urls.size(), index / 10 + (prefetch && index < 90 ? 1 : 0));
 			ok = true;
 		}();
 		if(!ok || ++count == 100)
@@ -579,6 +1138,390 @@ void RestReplyTest::testPagingIterate()
 	QVERIFY(completedSpy.wait(15000));
 	QCOMPARE(count, 100);
 
+	QCoreApplication::processEvents();//to ensure all deleteLaters have been called!
+	client->removeInterceptor(recorder);
+	delete recorder;
+	client->setPagingPrefetch(false);
+}
+
+void RestReplyTest::testPagingIterateParallel_data()
+{
+	QTest::addColumn<bool>("ordered");
+
+	QTest::newRow("ordered") << true;
+	QTest::newRow("unordered") << false;
+}
+
+void RestReplyTest::testPagingIterateParallel()
+{
+	QFETCH(bool, ordered);
+
+	auto paging = client->rootClass()->get<QtRestClient::Paging<JphPost*>>(QStringLiteral("pages/0"));
+	QVector<bool> seen(100, false);
+	auto count = 0;
+	auto lastIndex = -1;
+	auto inOrder = true;
+	paging->onSucceeded([&](int, QtRestClient::Paging<JphPost*> page){
+		page.iterateParallel([&](JphPost *data, int index){
+			inOrder = inOrder && index > lastIndex;
+			lastIndex = index;
+			if(data->id == index && index >= 0 && index < seen.size())
+				seen[index] = true;
+			data->deleteLater();
+			if(++count == 100)
+				emit test_unlock();
+			return true;
+		}, [&](QString error, int, QtRestClient::RestReply::ErrorType){
+			QFAIL(qUtf8Printable(error));
+			emit test_unlock();
+		}, 3, ordered);
+	});
+
+	QSignalSpy completedSpy(this, &RestReplyTest::test_unlock);
+	QVERIFY(completedSpy.wait(15000));
+	QCOMPARE(count, 100);
+	QVERIFY(!seen.contains(false));
+	if(ordered)
+		QVERIFY(inOrder);
+
+	QCoreApplication::processEvents();//to ensure all deleteLaters have been called!
+}
+
+void RestReplyTest::testPagingStream()
+{
+	auto paging = client->rootClass()->get<QtRestClient::Paging<JphPost*>>(QStringLiteral("pages/0"));
+	QtRestClient::PagingStream<JphPost*> stream;
+	auto count = 0;
+	auto inOrder = true;
+	auto maxBuffered = 0;
+	auto finished = false;
+	paging->onSucceeded([&](int, QtRestClient::Paging<JphPost*> page){
+		stream = page.stream();
+		stream.onItem([&](JphPost *data, int index){
+			inOrder = inOrder && data->id == count && index == count;
+			maxBuffered = qMax(maxBuffered, stream.buffered());
+			data->deleteLater();
+			//request the next chunk once the previous one was consumed
+			if(++count % 15 == 0)
+				stream.requestMore(15);
+		}).onFinished([&](){
+			finished = true;
+			emit test_unlock();
+		}).onError([&](QString error, int, QtRestClient::RestReply::ErrorType){
+			QFAIL(qUtf8Printable(error));
+			emit test_unlock();
+		});
+		stream.requestMore(15);
+	});
+
+	QSignalSpy completedSpy(this, &RestReplyTest::test_unlock);
+	QVERIFY(completedSpy.wait(15000));
+	QVERIFY(finished);
+	QCOMPARE(count, 100);
+	QVERIFY(inOrder);
+	QVERIFY(maxBuffered < 10);
+	QVERIFY(stream.isFinished());
+	QCOMPARE(stream.buffered(), 0);
+
+	QCoreApplication::processEvents();//to ensure all deleteLaters have been called!
+}
+
+void RestReplyTest::testPageCache()
+{
+	auto cache = new QtRestClient::PageCache(this);
+	client->setPageCache(cache);
+
+	QtRestClient::Paging<JphPost*> current;
+	auto fromCache = false;
+	auto load = [&](QtRestClient::GenericRestReply<QtRestClient::Paging<JphPost*>, QObject*> *reply) {
+		QSignalSpy completedSpy(this, &RestReplyTest::test_unlock);
+		current = {};
+		reply->onSucceeded([&, reply](int, QtRestClient::Paging<JphPost*> paging){
+			current = paging;
+			fromCache = reply->metrics().fromCache();
+			emit test_unlock();
+		})->onAllErrors([&](QString, int, QtRestClient::RestReply::ErrorType){
+			emit test_unlock();
+		});
+		return completedSpy.wait() && current.isValid();
+	};
+
+	//pages that do not own their items are never cached
+	QVERIFY(load(client->rootClass()->get<QtRestClient::Paging<JphPost*>>(QStringLiteral("pages/0"))));
+	auto unowned = current;
+	QVERIFY(load(unowned.next()));
+	QCOMPARE(cache->size(), 0);
+	unowned.deleteAllItems();
+	current.deleteAllItems();
+
+	client->setPagingOwnsItems(true);
+	QVERIFY(load(client->rootClass()->get<QtRestClient::Paging<JphPost*>>(QStringLiteral("pages/0"))));
+	auto first = current;
+	QCOMPARE(cache->size(), 0);
+
+	QVERIFY(load(first.next()));
+	auto second = current;
+	QVERIFY(!fromCache);
+	QCOMPARE(cache->size(), 1);
+
+	QVERIFY(load(second.previous()));
+	auto firstAgain = current;
+	QVERIFY(!fromCache);
+	QCOMPARE(cache->size(), 2);
+
+	//the second page is known now and must be served without a request
+	QVERIFY(load(firstAgain.next()));
+	QVERIFY(fromCache);
+	QCOMPARE(current.items(), second.items());
+	QCOMPARE(current.offset(), second.offset());
+	QCOMPARE(cache->size(), 2);
+
+	//items deleted before a cached reply completes are loaded again instead
+	auto reply = firstAgain.next();
+	auto deletedId = second.items().first()->id;
+	delete second.items().first();
+	QVERIFY(load(reply));
+	QVERIFY(!fromCache);
+	QCOMPARE(current.items().size(), 10);
+	QCOMPARE(current.items().first()->id, deletedId);
+	QCOMPARE(cache->size(), 2);
+	second = current;
+
+	//least recently used pages are evicted first
+	cache->setMaxPages(1);
+	QCOMPARE(cache->size(), 1);
+	QVERIFY(load(firstAgain.next()));
+	QVERIFY(fromCache);
+
+	client->setPageCache(nullptr);
+	client->setPagingOwnsItems(false);
+	cache->clear();
+	QCOMPARE(cache->size(), 0);
+	QCoreApplication::processEvents();//to ensure all deleteLaters have been called!
+	cache->deleteLater();
+}
+
+void RestReplyTest::testPagingFactories()
+{
+	QNetworkRequest request(QUrl(QStringLiteral("http://localhost/posts?limit=2&cursor=a")));
+	QtRestClient::StaticReply reply(request, 200, {});
+	reply.setRawHeader("Link", "<http://localhost/posts?page=3>; rel=\"next\", </posts?page=1>; rel=\"prev first\"");
+	reply.setRawHeader("X-Total-Count", "42");
+	QJsonArray items {1, 2};
+
+	//link header: items as body, links and total as headers
+	QtRestClient::LinkHeaderPagingFactory linkFactory;
+	QScopedPointer<QtRestClient::IPaging> paging(linkFactory.createPagingFromReply(client->serializer(), items, &reply));
+	QCOMPARE(paging->items(), items);
+	QCOMPARE(paging->total(), 42);
+	QVERIFY(paging->hasNext());
+	QCOMPARE(paging->next(), QUrl(QStringLiteral("http://localhost/posts?page=3")));
+	QVERIFY(paging->hasPrevious());
+	QCOMPARE(paging->previous(), QUrl(QStringLiteral("http://localhost/posts?page=1")));
+	auto links = QtRestClient::LinkHeaderPagingFactory::parseLinks(reply.rawHeader("Link"), reply.url());
+	QCOMPARE(links.size(), 3);
+	QCOMPARE(links.value(QStringLiteral("first")), paging->previous());
+
+	//cursor: the cursor replaces the one of the current URL
+	QtRestClient::CursorPagingFactory cursorFactory;
+	paging.reset(cursorFactory.createPagingFromReply(client->serializer(), QJsonObject {
+		{QStringLiteral("items"), items},
+		{QStringLiteral("nextCursor"), QStringLiteral("b+c=")},
+		{QStringLiteral("previousCursor"), QJsonValue::Null}
+	}, &reply));
+	QCOMPARE(paging->items(), items);
+	QVERIFY(paging->hasNext());
+	QUrlQuery query(paging->next());
+	QCOMPARE(query.queryItemValue(QStringLiteral("cursor"), QUrl::FullyDecoded), QStringLiteral("b+c="));
+	QCOMPARE(query.queryItemValue(QStringLiteral("limit")), QStringLiteral("2"));
+	QVERIFY(!paging->hasPrevious());
+
+	QVERIFY_EXCEPTION_THROWN(cursorFactory.createPagingFromReply(client->serializer(), QJsonValue(items), &reply), QJsonDeserializationException);
+
+	//page urls: only an unambiguous offset or page number is replaced
+	auto pageUrl = [&](const QString &next, int offset) {
+		QScopedPointer<QtRestClient::IPaging> offsetPaging(client->pagingFactory()->createPaging(client->serializer(), QJsonObject {
+			{QStringLiteral("offset"), 0},
+			{QStringLiteral("items"), QJsonArray {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}},
+			{QStringLiteral("next"), next}
+		}));
+		return client->pagingFactory()->pageUrl(offsetPaging.data(), offset);
+	};
+	QCOMPARE(pageUrl(QStringLiteral("http://localhost/posts?limit=10&offset=10"), 30),
+			 QUrl(QStringLiteral("http://localhost/posts?limit=10&offset=30")));
+	QCOMPARE(pageUrl(QStringLiteral("http://localhost/posts?page=1&per_page=10"), 30),
+			 QUrl(QStringLiteral("http://localhost/posts?page=3&per_page=10")));
+	QCOMPARE(pageUrl(QStringLiteral("http://localhost/posts?pageSize=10&page=2"), 30),
+			 QUrl(QStringLiteral("http://localhost/posts?pageSize=10&page=4")));
+	QCOMPARE(pageUrl(QStringLiteral("http://localhost/pages/1"), 30),
+			 QUrl(QStringLiteral("http://localhost/pages/3")));
+	QVERIFY(!pageUrl(QStringLiteral("http://localhost/posts?offset=10&skip=10"), 30).isValid());
+	QVERIFY(!pageUrl(QStringLiteral("http://localhost/posts/10?offset=20"), 30).isValid());
+}
+
+void RestReplyTest::testPagingModel_data()
+{
+	QTest::addColumn<bool>("cached");
+
+	QTest::newRow("uncached") << false;
+	QTest::newRow("cached") << true;
+}
+
+void RestReplyTest::testPagingModel()
+{
+	QFETCH(bool, cached);
+	QtRestClient::PageCache cache;
+	if(cached) {
+		client->setPagingOwnsItems(true);
+		client->setPageCache(&cache);
+	}
+
+	auto paging = client->rootClass()->get<QtRestClient::Paging<JphPost*>>(QStringLiteral("pages/0"));
+	QtRestClient::PagingModel<JphPost*> model;
+	model.setMaxLoadedPages(2);
+	paging->onSucceeded([&](int, QtRestClient::Paging<JphPost*> page){
+		model.setPaging(page);
+		emit test_unlock();
+	});
+
+	QSignalSpy completedSpy(this, &RestReplyTest::test_unlock);
+	QVERIFY(completedSpy.wait());
+	QCOMPARE(model.rowCount(), 10);
+	auto idRole = model.roleNames().key("id", -1);
+	QVERIFY(idRole > QtRestClient::PagingModelBase::ModelDataRole);
+	QCOMPARE(model.data(model.index(3), idRole).toInt(), 3);
+
+	//fetch two more pages -> the first one gets unloaded
+	QSignalSpy insertSpy(&model, &QAbstractItemModel::rowsInserted);
+	for(auto i = 0; i < 2; i++) {
+		QVERIFY(model.canFetchMore({}));
+		model.fetchMore({});
+		QVERIFY(!model.canFetchMore({}));
+		QVERIFY(insertSpy.wait());
+	}
+	QCOMPARE(model.rowCount(), 30);
+	QCOMPARE(model.loadedPages(), 2);
+	QVERIFY(!model.isRowLoaded(0));
+	QVERIFY(model.isRowLoaded(29));
+	QCOMPARE(model.data(model.index(25), idRole).toInt(), 25);
+
+	//accessing the unloaded page loads it again
+	QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+	QVERIFY(!model.data(model.index(0), idRole).isValid());
+	QVERIFY(changedSpy.wait());
+	QVERIFY(model.isRowLoaded(0));
+	QCOMPARE(model.loadedPages(), 2);
+	QCOMPARE(model.item(5)->id, 5);
+	QVERIFY(!model.isRowLoaded(15));
+
+	//unloaded pages are removed from the cache, and are requested again
+	if(cached) {
+		QVERIFY(cache.contains(server->url("pages/2")));
+		QVERIFY(!cache.contains(server->url("pages/1")));
+		QVERIFY(!model.data(model.index(15), idRole).isValid());
+		QVERIFY(changedSpy.wait());
+		QCOMPARE(model.item(15)->id, 15);
+		QVERIFY(cache.contains(server->url("pages/1")));
+	}
+
+	//failed pages are not requested again on every access, only once retried
+	auto failedRow = -1;
+	for(auto row : {0, 10, 20}) {
+		if(!model.isRowLoaded(row))
+			failedRow = row;
+	}
+	QVERIFY(failedRow >= 0);
+	auto failing = new FailingInterceptor();
+	client->addInterceptor(failing);
+	QSignalSpy errorSpy(&model, &QtRestClient::PagingModelBase::fetchError);
+	QVERIFY(!model.data(model.index(failedRow), idRole).isValid());
+	QVERIFY(errorSpy.wait());
+	QVERIFY(!model.data(model.index(failedRow), idRole).isValid());
+	QVERIFY(!errorSpy.wait(200));
+	QCOMPARE(failing->requestCount, 1);
+	client->removeInterceptor(failing);
+	delete failing;
+	model.retryFailedPages();
+	QVERIFY(!model.data(model.index(failedRow), idRole).isValid());
+	QVERIFY(changedSpy.wait());
+	QVERIFY(model.isRowLoaded(failedRow));
+
+	model.setPaging({});
+	QCOMPARE(model.rowCount(), 0);
+	client->setPageCache(nullptr);
+	client->setPagingOwnsItems(false);
+	QCoreApplication::processEvents();//to ensure all deleteLaters have been called!
+}
+
+void RestReplyTest::testPagingOwnsItems()
+{
+	client->setPagingOwnsItems(true);
+	auto reply = client->rootClass()->get<QtRestClient::Paging<JphPost*>>(QStringLiteral("pages/0"));
+	QtRestClient::Paging<JphPost*> paging;
+	reply->onSucceeded([&](int, QtRestClient::Paging<JphPost*> page){
+		paging = page;
+		emit test_unlock();
+	});
+
+	QSignalSpy completedSpy(this, &RestReplyTest::test_unlock);
+	QVERIFY(completedSpy.wait());
+	client->setPagingOwnsItems(false);
+	QVERIFY(paging.ownsItems());
+	auto items = paging.items();
+	QCOMPARE(items.size(), 10);
+	QPointer<JphPost> first = items.first();
+	QPointer<JphPost> kept = items.last();
+	QVERIFY(first->parent());
+	QCOMPARE(kept->parent(), first->parent());
+
+	//skipped items are not deleted one by one
+	paging.deleteAllItems();
+	QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+	QVERIFY(first);
+
+	//releasing the last copy deletes all items, except those that got a new parent
+	kept->setParent(this);
+	paging = {};
+	QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+	QVERIFY(!first);
+	QVERIFY(kept);
+	delete kept.data();
+}
+
+void RestReplyTest::testPagingCollect()
+{
+	QList<JphPost*> items;
+	auto complete = false;
+	auto collect = [&](int maxItems) {
+		QSignalSpy completedSpy(this, &RestReplyTest::test_unlock);
+		items.clear();
+		complete = false;
+		client->rootClass()->get<QtRestClient::Paging<JphPost*>>(QStringLiteral("pages/0"))
+				->collect([&](QList<JphPost*> data, bool done){
+					items = data;
+					complete = done;
+					emit test_unlock();
+				}, maxItems)
+				->onAllErrors([&](QString error, int, QtRestClient::RestReply::ErrorType){
+					QFAIL(qUtf8Printable(error));
+					emit test_unlock();
+				});
+		return completedSpy.wait(15000);
+	};
+
+	QVERIFY(collect(-1));
+	QVERIFY(complete);
+	QCOMPARE(items.size(), 100);
+	for(auto i = 0; i < items.size(); i++)
+		QCOMPARE(items[i]->id, i);
+	qDeleteAll(items);
+
+	QVERIFY(collect(25));
+	QVERIFY(!complete);
+	QCOMPARE(items.size(), 25);
+	QCOMPARE(items.last()->id, 24);
+	qDeleteAll(items);
+
 	QCoreApplication::processEvents();//to ensure all deleteLaters have been called!
 }
 
@@ -647,6 +1590,87 @@ void RestReplyTest::testSimpleExtension()
 	full->deleteLater();
 }
 
+void RestReplyTest::testSimpleExtendAll()
+{
+	auto first = new SimpleJphPost(1, "Title1", QStringLiteral("/posts/1"), this);
+	auto second = new SimpleJphPost(2, "Title2", QStringLiteral("/posts/2"), this);
+	auto duplicate = new SimpleJphPost(1, "Title1", QStringLiteral("/posts/1"), this);
+	auto noExtension = new SimpleJphPost(3, "Title3", QUrl(), this);
+
+	auto extended = SimpleJphPost::extendAll(client, {first, second, duplicate, noExtension}, 2);
+	QFutureWatcher<JphPost*> watcher;
+	QSignalSpy finishedSpy(&watcher, &QFutureWatcherBase::finished);
+	watcher.setFuture(extended);
+	QVERIFY(finishedSpy.wait());
+
+	//one request per distinct href
+	QCOMPARE(extended.results().size(), 2);
+	QVERIFY(first->currentExtended());
+	QCOMPARE(first->currentExtended()->id, 1);
+	QCOMPARE(duplicate->currentExtended(), first->currentExtended());
+	QVERIFY(second->currentExtended());
+	QCOMPARE(second->currentExtended()->id, 2);
+	QVERIFY(!noExtension->currentExtended());
+
+	//already extended objects are skipped
+	auto again = SimpleJphPost::extendAll(client, {first, second, duplicate});
+	QVERIFY(again.isFinished());
+	QCOMPARE(again.resultCount(), 0);
+
+	qDeleteAll(extended.results());
+	first->deleteLater();
+	second->deleteLater();
+	duplicate->deleteLater();
+	noExtension->deleteLater();
+
+	//bulk: one request per batch of distinct ids, limited to maxConcurrent at once
+	auto bulk = new BulkInterceptor();
+	client->addInterceptor(bulk);
+	QList<QtRestClient::Simple<JphPost*>*> objects;
+	for(auto i = 1; i <= 5; i++)
+		objects.append(new SimpleJphPost(i, QStringLiteral("Title%1").arg(i), QStringLiteral("/posts/%1").arg(i), this));
+	auto bulkDuplicate = new SimpleJphPost(1, QStringLiteral("Title1"), QStringLiteral("/posts/1"), this);
+	objects.append(bulkDuplicate);
+
+	auto bulkExtended = SimpleJphPost::extendAll(client, objects, QStringLiteral("bulk"), "id", QStringLiteral("ids"), 2, 1);
+	QFutureWatcher<QList<JphPost*>> bulkWatcher;
+	QSignalSpy bulkSpy(&bulkWatcher, &QFutureWatcherBase::finished);
+	bulkWatcher.setFuture(bulkExtended);
+	QVERIFY(bulkSpy.wait());
+	QCOMPARE(bulk->requestedIds, QStringList({QStringLiteral("1,2"), QStringLiteral("3,4"), QStringLiteral("5")}));
+	QCOMPARE(bulk->maxRunning, 1);
+	QCOMPARE(bulkExtended.results().size(), 3);
+	for(auto i = 0; i < 5; i++) {
+		QVERIFY(objects[i]->currentExtended());
+		QCOMPARE(objects[i]->currentExtended()->id, i + 1);
+	}
+	QCOMPARE(bulkDuplicate->currentExtended(), objects[0]->currentExtended());
+
+	//extensions that were not requested, or whose objects are gone, are not reported
+	bulk->extraIds = QStringList {QStringLiteral("99")};
+	auto kept = new SimpleJphPost(6, QStringLiteral("Title6"), QStringLiteral("/posts/6"), this);
+	auto gone = new SimpleJphPost(7, QStringLiteral("Title7"), QStringLiteral("/posts/7"), this);
+	auto filtered = SimpleJphPost::extendAll(client, {kept, gone}, QStringLiteral("bulk"), "id");
+	delete gone;
+	QFutureWatcher<QList<JphPost*>> filteredWatcher;
+	QSignalSpy filteredSpy(&filteredWatcher, &QFutureWatcherBase::finished);
+	filteredWatcher.setFuture(filtered);
+	QVERIFY(filteredSpy.wait());
+	QCOMPARE(filtered.results().size(), 1);
+	QCOMPARE(filtered.result().size(), 1);
+	QCOMPARE(filtered.result().first(), kept->currentExtended());
+	QCOMPARE(kept->currentExtended()->id, 6);
+	qDeleteAll(filtered.result());
+	kept->deleteLater();
+
+	client->removeInterceptor(bulk);
+	delete bulk;
+	for(const auto &list : bulkExtended.results())
+		qDeleteAll(list);
+	for(auto object : objects)
+		object->deleteLater();
+}
+
 void RestReplyTest::testSimplePagingIterate()
 {
 	QNetworkRequest request(server->url("pagelets/0"));
@@ -7,4 +7,5 @@ SUBDIRS += \
 	RestClientTest \
 	RestReplyTest \
 	IntegrationTest \
-	RestBuilderTest
+	RestBuilderTest \
+	AwaitableTest
@@ -168,6 +168,36 @@ void HttpServer::setAdvancedData()
 	setData(root);
 }
 
+bool HttpServer::rangesEnabled() const
+{
+	return _rangesEnabled;
+}
+
+void HttpServer::setRangesEnabled(bool enabled)
+{
+	_rangesEnabled = enabled;
+}
+
+bool HttpServer::rangesIgnored() const
+{
+	return _rangesIgnored;
+}
+
+void HttpServer::setRangesIgnored(bool ignored)
+{
+	_rangesIgnored = ignored;
+}
+
+bool HttpServer::headEnabled() const
+{
+	return _headEnabled;
+}
+
+void HttpServer::setHeadEnabled(bool enabled)
+{
+	_headEnabled = enabled;
+}
+
 void HttpServer::connected()
 {
 	while(hasPendingConnections())
@@ -220,6 +250,8 @@ HttpConnection::HttpConnection(QTcpSocket *socket, HttpServer *parent) :
 	_path(),
 	_hdrDone(false),
 	_len(0),
+	_rangeBegin(-1),
+	_rangeEnd(-1),
 	_content()
 {
 	_socket->setParent(this);
@@ -251,6 +283,11 @@ void HttpConnection::readyRead()
 				}
 			} else if(nextLine.startsWith("Content-Length: "))
 				_len = nextLine.mid(16).toInt();
+			else if(nextLine.startsWith("Range: bytes=")) {
+				auto range = nextLine.mid(13).split('-');
+				_rangeBegin = range.value(0).toLongLong();
+				_rangeEnd = range.value(1).toLongLong();
+			}
 		}
 	}
 }
@@ -261,7 +298,12 @@ void HttpConnection::reply()
 	auto segments = superPath.first().split('/');
 
 	QByteArray doc;
+	QByteArray status = "200 OK";
+	QByteArray extraHeaders;
 	try {
+		if(_verb == "HEAD" && !_server->headEnabled())
+			throw QStringLiteral("method not allowed");
+
 		//read content if required
 		if(_content.size() < _len) {
 			_content += _socket->readAll();
@@ -282,7 +324,17 @@ void HttpConnection::reply()
 		else
 			doc = QJsonDocument(subValue.toArray()).toJson(QJsonDocument::Compact);
 
-		_socket->write("HTTP/1.1 200 OK\r\n");
+		if(_server->rangesEnabled()) {
+			extraHeaders += "Accept-Ranges: bytes\r\n";
+			if(_rangeBegin >= 0 && _verb == "GET" && !_server->rangesIgnored()) {
+				auto rangeEnd = qMin(_rangeEnd, static_cast<qint64>(doc.size()) - 1);
+				extraHeaders += "Content-Range: bytes " + QByteArray::number(_rangeBegin) +
+								'-' + QByteArray::number(rangeEnd) +
+								'/' + QByteArray::number(doc.size()) + "\r\n";
+				doc = doc.mid(static_cast<int>(_rangeBegin), static_cast<int>(rangeEnd - _rangeBegin + 1));
+				status = "206 Partial Content";
+			}
+		}
 	} catch(QString &e) {
 		qWarning().noquote() << "SERVER-Error[" << _verb <<  _path << "]:" << e;
 
@@ -290,13 +342,16 @@ void HttpConnection::reply()
 		error[QStringLiteral("message")] = e;
 		doc = QJsonDocument(error).toJson(QJsonDocument::Compact);
 
-		_socket->write("HTTP/1.1 404 Not Found\r\n");
+		status = _verb == "HEAD" && !_server->headEnabled() ? "405 Method Not Allowed" : "404 Not Found";
 	}
 
+	_socket->write("HTTP/1.1 " + status + "\r\n");
 	_socket->write("Content-Length: " + QByteArray::number(doc.size()) + "\r\n");
 	_socket->write("Content-Type: application/json\r\n");
+	_socket->write(extraHeaders);
 	_socket->write("Connection: Closed\r\n");
 	_socket->write("\r\n");
-	_socket->write(doc + "\r\n");
+	if(_verb != "HEAD")
+		_socket->write(doc + "\r\n");
 	_socket->flush();
 }
@@ -25,6 +25,8 @@ private:
 
 	bool _hdrDone;
 	qint64 _len;
+	qint64 _rangeBegin;
+	qint64 _rangeEnd;
 	QByteArray _content;
 };
 
@@ -50,6 +52,13 @@ public:
 	void setDefaultData();
 	void setAdvancedData();
 
+	bool rangesEnabled() const;
+	void setRangesEnabled(bool enabled);
+	bool rangesIgnored() const;
+	void setRangesIgnored(bool ignored);
+	bool headEnabled() const;
+	void setHeadEnabled(bool enabled);
+
 signals:
 	void dataChanged(QJsonObject data);
 
@@ -58,6 +67,9 @@ private slots:
 
 private:
 	QJsonObject _data;
+	bool _rangesEnabled = false;
+	bool _rangesIgnored = false;
+	bool _headEnabled = true;
 
 	QJsonValue applyDataImpl(bool isPut, QByteArrayList path, QJsonValue cData, const QJsonObject &data);
 };
@@ -380,6 +380,8 @@ void ClassBuilder::writeApiCreation()
 	auto parameters = root[QStringLiteral("parameters")].toObject();
 	for(auto it = parameters.constBegin(); it != parameters.constEnd(); it++)
 		source << "\t\tclient->addGlobalParameter(QStringLiteral(\"" << it.key() << "\"), " << expr(it.value().toString(), true) << ");\n";
+	if(root[QStringLiteral("warmUp")].toBool(true))
+		source << "\t\tclient->warmUp();\n";
 }
 
 bool ClassBuilder::writeMethodPath(const MethodInfo &info)